@@ -0,0 +1,20 @@
+// Frame stepping for a batch of sprite animations, one fixed timestep per iteration
+#include <vector>
+#include "Animation.h"
+#include "Benchmark.h"
+#include "BenchmarkFixtures.h"
+#include "GameSprite.h"
+
+static void BM_AnimationUpdate(bench::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    // Same sheet layout as the Player: 4 frames per row, switching every 0.25s
+    std::vector<Animation> animations(count, Animation(sf::Vector2i(0, 0), sf::Vector2u(4, 3), 0.25f, 16, 16));
+    std::vector<GameSprite> sprites(count);
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; i++) {
+            animations[i].Update(0, bench::FIXED_TIMESTEP, sprites[i]);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_AnimationUpdate)->Arg(1)->Arg(1000);
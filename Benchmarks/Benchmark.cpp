@@ -0,0 +1,278 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace bench {
+
+    State::State(int64_t maxIterations, std::vector<int64_t> args)
+        : maxIterations(maxIterations), args(std::move(args)) {
+    }
+
+    State::Iterator State::begin() {
+        Iterator it(this);
+        it.remaining = maxIterations;
+        ResumeTiming();
+        return it;
+    }
+
+    void State::PauseTiming() {
+        if (!running) {
+            return;
+        }
+        realSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - realStart).count();
+        cpuSeconds += static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        running = false;
+    }
+
+    void State::ResumeTiming() {
+        if (running) {
+            return;
+        }
+        realStart = std::chrono::steady_clock::now();
+        cpuStart = std::clock();
+        running = true;
+    }
+
+    void State::FinishKeepRunning() {
+        PauseTiming();
+    }
+
+    namespace {
+        std::vector<std::unique_ptr<Benchmark>>& registry() {
+            static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+            return benchmarks;
+        }
+
+        struct Result {
+            std::string name;
+            std::string runName;
+            int64_t iterations;
+            double realNs;   // Per iteration
+            double cpuNs;
+            double itemsPerSecond;
+            std::string label;
+            std::map<std::string, double> counters;
+        };
+
+        struct Options {
+            std::string filter = ".*";
+            std::string format = "console";
+            std::string outFile;
+            double minTime = 0.5;
+        };
+
+        bool readFlag(const std::string& arg, const char* flag, std::string& value) {
+            std::string prefix = std::string("--") + flag + "=";
+            if (arg.rfind(prefix, 0) != 0) {
+                return false;
+            }
+            value = arg.substr(prefix.size());
+            return true;
+        }
+
+        std::string jsonEscape(const std::string& text) {
+            std::string out;
+            for (char c : text) {
+                switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                default: out += c; break;
+                }
+            }
+            return out;
+        }
+
+        std::string jsonNumber(double value) {
+            if (!std::isfinite(value)) {
+                return "0";
+            }
+            std::ostringstream out;
+            out << std::setprecision(17) << value;
+            return out.str();
+        }
+
+        void writeJson(std::ostream& out, const std::vector<Result>& results, const char* executable) {
+            char date[64];
+            std::time_t now = std::time(nullptr);
+            std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+            out << "{\n  \"context\": {\n";
+            out << "    \"date\": \"" << date << "\",\n";
+            out << "    \"executable\": \"" << jsonEscape(executable) << "\",\n";
+            out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+            out << "    \"library_build_type\": \"release\"\n";
+#else
+            out << "    \"library_build_type\": \"debug\"\n";
+#endif
+            out << "  },\n  \"benchmarks\": [\n";
+            for (size_t i = 0; i < results.size(); i++) {
+                const Result& r = results[i];
+                out << "    {\n";
+                out << "      \"name\": \"" << jsonEscape(r.name) << "\",\n";
+                out << "      \"run_name\": \"" << jsonEscape(r.runName) << "\",\n";
+                out << "      \"run_type\": \"iteration\",\n";
+                out << "      \"iterations\": " << r.iterations << ",\n";
+                out << "      \"real_time\": " << jsonNumber(r.realNs) << ",\n";
+                out << "      \"cpu_time\": " << jsonNumber(r.cpuNs) << ",\n";
+                out << "      \"time_unit\": \"ns\"";
+                if (r.itemsPerSecond > 0.0) {
+                    out << ",\n      \"items_per_second\": " << jsonNumber(r.itemsPerSecond);
+                }
+                for (const auto& [key, value] : r.counters) {
+                    out << ",\n      \"" << jsonEscape(key) << "\": " << jsonNumber(value);
+                }
+                if (!r.label.empty()) {
+                    out << ",\n      \"label\": \"" << jsonEscape(r.label) << "\"";
+                }
+                out << "\n    }" << (i + 1 < results.size() ? "," : "") << '\n';
+            }
+            out << "  ]\n}\n";
+        }
+
+        void writeConsoleHeader() {
+            std::cout << std::left << std::setw(40) << "Benchmark" << std::right
+                << std::setw(16) << "Time" << std::setw(16) << "CPU" << std::setw(14) << "Iterations" << '\n';
+            std::cout << std::string(86, '-') << '\n';
+        }
+
+        void writeConsoleLine(const Result& r) {
+            std::cout << std::left << std::setw(40) << r.name << std::right << std::fixed << std::setprecision(1)
+                << std::setw(13) << r.realNs << " ns" << std::setw(13) << r.cpuNs << " ns"
+                << std::setw(14) << r.iterations;
+            if (r.itemsPerSecond > 0.0) {
+                std::cout << " items/s=" << std::setprecision(3) << std::scientific << r.itemsPerSecond << std::fixed;
+            }
+            for (const auto& [key, value] : r.counters) {
+                std::cout << ' ' << key << '=' << value;
+            }
+            if (!r.label.empty()) {
+                std::cout << ' ' << r.label;
+            }
+            std::cout << std::defaultfloat << '\n';
+        }
+    }
+
+    Benchmark* RegisterBenchmark(const char* name, Benchmark::Function function) {
+        registry().push_back(std::make_unique<Benchmark>(name, std::move(function)));
+        return registry().back().get();
+    }
+
+    class Runner {
+    public:
+        explicit Runner(const Options& options) : options(options) {}
+
+        Result Run(const Benchmark& benchmark, const std::vector<int64_t>& args, const std::string& name) {
+            // Grow the iteration count until one run lasts at least minTime, like Google Benchmark
+            int64_t iterations = benchmark.fixedIterations > 0 ? benchmark.fixedIterations : 1;
+            while (true) {
+                State state(iterations, args);
+                benchmark.function(state);
+                bool done = benchmark.fixedIterations > 0 || state.realSeconds >= options.minTime || iterations >= 1000000000;
+                if (done) {
+                    Result result;
+                    result.name = name;
+                    result.runName = name;
+                    result.iterations = iterations;
+                    result.realNs = state.realSeconds * 1e9 / iterations;
+                    result.cpuNs = state.cpuSeconds * 1e9 / iterations;
+                    result.itemsPerSecond = state.realSeconds > 0.0 ? state.itemsProcessed / state.realSeconds : 0.0;
+                    result.label = state.label;
+                    result.counters = state.counters;
+                    return result;
+                }
+                double multiplier = state.realSeconds > 0.0 ? options.minTime * 1.4 / state.realSeconds : 10.0;
+                multiplier = std::clamp(multiplier, 2.0, 10.0);
+                iterations = static_cast<int64_t>(std::ceil(iterations * multiplier));
+            }
+        }
+
+    private:
+        const Options& options;
+    };
+
+    int RunAll(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            std::string value;
+            if (readFlag(arg, "benchmark_filter", value)) {
+                options.filter = value;
+            }
+            else if (readFlag(arg, "benchmark_format", value)) {
+                options.format = value;
+            }
+            else if (readFlag(arg, "benchmark_out", value)) {
+                options.outFile = value;
+            }
+            else if (readFlag(arg, "benchmark_min_time", value)) {
+                options.minTime = std::atof(value.c_str());
+            }
+            else {
+                std::cerr << "Unknown argument: " << arg << '\n'
+                    << "Usage: " << argv[0] << " [--benchmark_filter=<regex>] [--benchmark_format=console|json]"
+                    << " [--benchmark_out=<file.json>] [--benchmark_min_time=<seconds>]" << '\n';
+                return 1;
+            }
+        }
+        if (options.format != "console" && options.format != "json") {
+            std::cerr << "Unknown --benchmark_format: " << options.format << '\n';
+            return 1;
+        }
+
+        std::regex filter;
+        try {
+            filter = std::regex(options.filter);
+        }
+        catch (const std::regex_error&) {
+            std::cerr << "Invalid --benchmark_filter: " << options.filter << '\n';
+            return 1;
+        }
+
+        Runner runner(options);
+        std::vector<Result> results;
+        bool console = options.format == "console";
+        if (console) {
+            writeConsoleHeader();
+        }
+        for (const auto& benchmark : registry()) {
+            std::vector<std::vector<int64_t>> argSets = benchmark->argSets;
+            if (argSets.empty()) {
+                argSets.push_back({});
+            }
+            for (const auto& args : argSets) {
+                std::string name = benchmark->name;
+                for (int64_t arg : args) {
+                    name += "/" + std::to_string(arg);
+                }
+                if (!std::regex_search(name, filter)) {
+                    continue;
+                }
+                results.push_back(runner.Run(*benchmark, args, name));
+                if (console) {
+                    writeConsoleLine(results.back());
+                }
+            }
+        }
+
+        if (!console) {
+            writeJson(std::cout, results, argv[0]);
+        }
+        if (!options.outFile.empty()) {
+            std::ofstream out(options.outFile);
+            if (!out) {
+                std::cerr << "Failed to open " << options.outFile << '\n';
+                return 1;
+            }
+            writeJson(out, results, argv[0]);
+        }
+        return 0;
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+// Minimal benchmark harness modelled on Google Benchmark: the same registration
+// macro, State loop and JSON report layout, so results can be compared with the
+// usual tooling (e.g. compare.py) without pulling in the dependency.
+//
+//     static void BM_Something(bench::State& state) {
+//         Setup(state.range(0));
+//         for (auto _ : state) {
+//             DoWork();
+//         }
+//         state.SetItemsProcessed(state.iterations());
+//     }
+//     BENCHMARK(BM_Something)->Arg(10)->Arg(1000);
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define BENCHMARK_UNUSED __attribute__((unused))
+#else
+#define BENCHMARK_UNUSED
+#endif
+
+namespace bench {
+
+    class State {
+    public:
+        State(int64_t maxIterations, std::vector<int64_t> args);
+
+        // Range-for support: `for (auto _ : state)` runs the body iterations() times
+        struct BENCHMARK_UNUSED Value {};
+        class Iterator {
+        public:
+            explicit Iterator(State* state) : state(state) {}
+            Value operator*() const { return {}; }
+            Iterator& operator++() { remaining--; return *this; }
+            bool operator!=(const Iterator&) {
+                if (remaining > 0) {
+                    return true;
+                }
+                state->FinishKeepRunning();
+                return false;
+            }
+        private:
+            friend class State;
+            State* state;
+            int64_t remaining = 0;
+        };
+        Iterator begin();
+        Iterator end() { return Iterator(this); }
+
+        // Exclude per-iteration setup from the measurement
+        void PauseTiming();
+        void ResumeTiming();
+
+        int64_t range(size_t index = 0) const { return args.at(index); }
+        int64_t iterations() const { return maxIterations; }
+        void SetItemsProcessed(int64_t items) { itemsProcessed = items; }
+        void SetLabel(const std::string& text) { label = text; }
+
+        // Extra per-run values reported alongside the timings
+        std::map<std::string, double> counters;
+
+    private:
+        friend class Runner;
+        void FinishKeepRunning();
+
+        int64_t maxIterations;
+        std::vector<int64_t> args;
+        bool running = false;
+        std::chrono::steady_clock::time_point realStart;
+        std::clock_t cpuStart = 0;
+        double realSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        int64_t itemsProcessed = 0;
+        std::string label;
+    };
+
+    class Benchmark {
+    public:
+        using Function = std::function<void(State&)>;
+        Benchmark(std::string name, Function function) : name(std::move(name)), function(std::move(function)) {}
+
+        Benchmark* Arg(int64_t value) { argSets.push_back({ value }); return this; }
+        Benchmark* Args(std::vector<int64_t> values) { argSets.push_back(std::move(values)); return this; }
+        // Fixed iteration count instead of running until the minimum time is reached
+        Benchmark* Iterations(int64_t count) { fixedIterations = count; return this; }
+
+    private:
+        friend class Runner;
+        friend int RunAll(int argc, char** argv);
+        std::string name;
+        Function function;
+        std::vector<std::vector<int64_t>> argSets;
+        int64_t fixedIterations = 0;
+    };
+
+    Benchmark* RegisterBenchmark(const char* name, Benchmark::Function function);
+
+    // Parses --benchmark_* flags, runs every registered benchmark and prints the report.
+    // Returns the process exit code.
+    int RunAll(int argc, char** argv);
+
+    // Keeps the optimiser from discarding a computed value
+    template <typename T>
+    inline void DoNotOptimize(T const& value) {
+#if defined(_MSC_VER)
+        static volatile const void* sink;
+        sink = &value;
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+}
+
+#define BENCHMARK_CONCAT_(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_(a, b)
+#define BENCHMARK(fn) \
+    static ::bench::Benchmark* BENCHMARK_CONCAT(benchmarkRegistration_, __LINE__) = ::bench::RegisterBenchmark(#fn, fn)
@@ -0,0 +1,44 @@
+#pragma once
+// Shared setup for the gameplay benchmarks
+#include <string>
+#include <vector>
+#include "LevelData.h"
+#include "Map.h"
+
+namespace bench {
+    inline const char* const TEST_LEVEL = "Assets/Map/01testlevel.rmap";
+    inline const char* const TEST_LEVEL_COMPILED = "Assets/Map/01testlevel.bmap";
+    constexpr float FIXED_TIMESTEP = 1.0f / 120.0f;
+
+    inline sf::Vector2f TileCentre(int col, int row) {
+        const int tileSize = Map::getTileSize();
+        return { col * tileSize + tileSize / 2.0f, row * tileSize + tileSize / 2.0f };
+    }
+
+    // Square dirt level of the given size with a horizontal tunnel every eighth row
+    inline ParsedLevel LargeLevel(int tiles) {
+        std::string text;
+        text.reserve(static_cast<size_t>(tiles + 1) * tiles);
+        for (int row = 0; row < tiles; row++) {
+            text.append(tiles, row == 0 ? '1' : (row % 8 == 4 ? '0' : '2'));
+            text += '\n';
+        }
+        ParsedLevel level;
+        level.parse(text, "generated");
+        return level;
+    }
+
+    // Centres of every open tile, so spawned enemies can actually path and move
+    inline std::vector<sf::Vector2f> OpenTiles(const Map& map) {
+        std::vector<sf::Vector2f> tiles;
+        sf::Vector2i grid = map.getGridSize();
+        for (int row = 0; row < grid.y; row++) {
+            for (int col = 0; col < grid.x; col++) {
+                if (map.getTileAtGrid(col, row) == TileType::Empty) {
+                    tiles.push_back(TileCentre(col, row));
+                }
+            }
+        }
+        return tiles;
+    }
+}
@@ -0,0 +1,13 @@
+// Entry point for the benchmark suite. Run from the DIGDUG directory so the relative
+// asset paths resolve, e.g.
+//     ./digdug_benchmarks --benchmark_format=json --benchmark_out=results.json
+#include "Benchmark.h"
+#include "Log.h"
+#include "Runtime.h"
+
+int main(int argc, char** argv) {
+    // No window, textures or audio: only simulation cost is measured
+    Runtime::SetHeadless(true);
+    Log::SetLevel(LogLevel::Warning);
+    return bench::RunAll(argc, argv);
+}
@@ -0,0 +1,63 @@
+// Per-tick enemy cost at increasing enemy counts: the Pooka pathing pass on its own,
+// and the full EnemyManager::Update (flow field, pathing, rocks, collisions, cleanup).
+#include <algorithm>
+#include "Benchmark.h"
+#include "BenchmarkFixtures.h"
+#include "EnemyManager.h"
+#include "FlowField.h"
+#include "GameState.h"
+#include "Map.h"
+#include "Player.h"
+#include "Pooka.h"
+#include "Random.h"
+
+static void BM_PookaUpdate(bench::State& state) {
+    const int enemyCount = static_cast<int>(state.range(0));
+    Map map;
+    map.loadFromFile(bench::TEST_LEVEL);
+    Player player(&map);
+    std::vector<sf::Vector2f> openTiles = bench::OpenTiles(map);
+
+    Random rng(12345);
+    PookaStore pookas(&map, &player, &rng);
+    pookas.Reserve(enemyCount);
+    for (int i = 0; i < enemyCount; i++) {
+        pookas.Spawn(openTiles[i % openTiles.size()]);
+    }
+    sf::Vector2f playerPosition = openTiles[openTiles.size() / 2];
+
+    // Same per-tick work as EnemyManager: refresh the chase field, then update every Pooka
+    FlowField chaseField;
+    for (auto _ : state) {
+        chaseField.Update(map, playerPosition);
+        pookas.Update(bench::FIXED_TIMESTEP, playerPosition, chaseField);
+    }
+    state.SetItemsProcessed(state.iterations() * enemyCount);
+}
+BENCHMARK(BM_PookaUpdate)->Arg(10)->Arg(1000)->Arg(100000);
+
+static void BM_EnemyManagerUpdate(bench::State& state) {
+    const int enemyCount = static_cast<int>(state.range(0));
+    Map map;
+    map.loadFromFile(bench::TEST_LEVEL);
+    Player player(&map);
+    GameState gameState;
+    gameState.setGameState(States::GAME);
+    std::vector<sf::Vector2f> openTiles = bench::OpenTiles(map);
+
+    EnemyManager enemies(&map, &player, enemyCount);
+    enemies.SetGameState(&gameState);
+    enemies.SetSeed(12345);
+    enemies.Initialise();
+    for (int i = 0; i < enemyCount; i++) {
+        enemies.SpawnEnemy(EnemyType::POOKA, openTiles[i % openTiles.size()]);
+    }
+    enemies.SpawnRocksFromMap();
+    sf::Vector2f playerPosition = openTiles[openTiles.size() / 2];
+
+    for (auto _ : state) {
+        enemies.Update(bench::FIXED_TIMESTEP, playerPosition);
+    }
+    state.SetItemsProcessed(state.iterations() * enemyCount);
+}
+BENCHMARK(BM_EnemyManagerUpdate)->Arg(10)->Arg(1000)->Arg(100000);
@@ -0,0 +1,121 @@
+// Map loading (text and compiled), background stage preparation and swap-in, scrolling over chunked
+// terrain, full buildTiles() rebuilds vs. setTileAt() patching single cells, and point queries.
+#include "Benchmark.h"
+#include "BenchmarkFixtures.h"
+#include "Map.h"
+
+static void BM_MapLoadFromFile(bench::State& state) {
+    Map map;
+    for (auto _ : state) {
+        map.loadFromFile(bench::TEST_LEVEL);
+    }
+}
+BENCHMARK(BM_MapLoadFromFile);
+
+// Same level compiled to .bmap: mapped and copied, no text parsing
+static void BM_MapLoadCompiled(bench::State& state) {
+    Map map;
+    for (auto _ : state) {
+        map.loadFromFile(bench::TEST_LEVEL_COMPILED);
+    }
+}
+BENCHMARK(BM_MapLoadCompiled);
+
+// The work StageManager::prefetch moves onto a worker thread
+static void BM_MapPrepareStage(bench::State& state) {
+    Map::Stage stage;
+    for (auto _ : state) {
+        Map::prepareStage(bench::TEST_LEVEL_COMPILED, 0, stage);
+    }
+}
+BENCHMARK(BM_MapPrepareStage);
+
+// What is left on the main thread at a stage transition
+static void BM_MapSwapStage(bench::State& state) {
+    Map map;
+    Map::Stage stage;
+    Map::prepareStage(bench::TEST_LEVEL_COMPILED, 0, stage);
+    for (auto _ : state) {
+        map.swapStage(stage);
+    }
+}
+BENCHMARK(BM_MapSwapStage);
+
+static void BM_MapBuildTiles(bench::State& state) {
+    Map map;
+    map.loadFromFile(bench::TEST_LEVEL);
+    for (auto _ : state) {
+        map.buildTiles();
+    }
+}
+BENCHMARK(BM_MapBuildTiles);
+
+// Camera panning diagonally across a large level, one tile per iteration
+static void BM_MapScroll(bench::State& state) {
+    const int tiles = static_cast<int>(state.range(0));
+    Map map;
+    map.loadLevel(bench::LargeLevel(tiles).view());
+    const float tileSize = static_cast<float>(Map::getTileSize());
+    const sf::Vector2f viewSize(224, 270);
+    const int steps = tiles - static_cast<int>(viewSize.y / tileSize) - 1;
+    int i = 0;
+    for (auto _ : state) {
+        float offset = (i++ % steps) * tileSize;
+        map.setVisibleArea(sf::FloatRect({ offset, offset }, viewSize));
+    }
+}
+BENCHMARK(BM_MapScroll)->Arg(64)->Arg(1024)->Arg(4096);
+
+// Dig and refill cells across the whole grid, the same path Player::createTunnel takes.
+// The chunks are built first, as they are in play, so each edit patches its cells in place.
+static void BM_MapSetTileAt(bench::State& state) {
+    Map map;
+    map.loadFromFile(bench::TEST_LEVEL);
+    map.setVisibleArea(sf::FloatRect({ 0, 0 }, sf::Vector2f(map.getMapSize())));
+    sf::Vector2i grid = map.getGridSize();
+    const int cells = grid.x * grid.y;
+    int i = 0;
+    for (auto _ : state) {
+        int cell = i % cells;
+        sf::Vector2f centre = bench::TileCentre(cell % grid.x, cell / grid.x);
+        map.setTileAt(centre.x, centre.y, (i / cells) % 2 == 0 ? TileType::Empty : TileType::Dirt1);
+        i++;
+    }
+}
+BENCHMARK(BM_MapSetTileAt);
+
+// An edit followed by the next frame's visibility pass, which must not rebuild the patched chunk
+static void BM_MapDigAndRedraw(bench::State& state) {
+    Map map;
+    map.loadFromFile(bench::TEST_LEVEL);
+    sf::Vector2i grid = map.getGridSize();
+    const sf::FloatRect view({ 0, 0 }, sf::Vector2f(map.getMapSize()));
+    const int cells = grid.x * grid.y;
+    int i = 0;
+    for (auto _ : state) {
+        int cell = i % cells;
+        sf::Vector2f centre = bench::TileCentre(cell % grid.x, cell / grid.x);
+        map.setTileAt(centre.x, centre.y, (i / cells) % 2 == 0 ? TileType::Empty : TileType::Dirt1);
+        map.setVisibleArea(view);
+        i++;
+    }
+}
+BENCHMARK(BM_MapDigAndRedraw);
+
+// Sweeps every pixel of the map once per iteration, like collision probes do
+static void BM_MapGetTileAt(bench::State& state) {
+    Map map;
+    map.loadFromFile(bench::TEST_LEVEL);
+    sf::Vector2i size = map.getMapSize();
+    for (auto _ : state) {
+        int solid = 0;
+        for (int y = 0; y < size.y; y++) {
+            for (int x = 0; x < size.x; x++) {
+                solid += Map::isSolidTile(map.getTileAt(static_cast<float>(x), static_cast<float>(y)));
+            }
+        }
+        bench::DoNotOptimize(solid);
+    }
+    state.SetItemsProcessed(state.iterations() * size.x * size.y);
+}
+BENCHMARK(BM_MapGetTileAt);
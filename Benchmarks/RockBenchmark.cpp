@@ -0,0 +1,57 @@
+// A rock shaking loose, falling down a dug shaft through a column of Pookas and breaking
+// on the dirt below. One iteration is one complete fall.
+#include "Benchmark.h"
+#include "BenchmarkFixtures.h"
+#include "EnemyManager.h"
+#include "GameState.h"
+#include "Map.h"
+#include "Player.h"
+
+static void BM_RockFallAndSquash(bench::State& state) {
+    const int SHAFT_COL = 6;
+    const int ROCK_ROW = 2;
+    const int SHAFT_BOTTOM = 11;   // Last open row; the rock breaks on the dirt under it
+    const int MAX_TICKS = 120 * 10;
+
+    Map map;
+    Player player(&map);
+    GameState gameState;
+    gameState.setGameState(States::GAME);
+    EnemyManager enemies(&map, &player, 16);
+    enemies.SetGameState(&gameState);
+    enemies.Initialise();
+    // Far corner, so the Pookas mill about in the shaft instead of leaving it
+    sf::Vector2f playerPosition = bench::TileCentre(0, 14);
+
+    long long ticks = 0;
+    long long squashed = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        map.loadFromFile(bench::TEST_LEVEL);
+        enemies.ClearAllEnemies();
+        enemies.ClearAllRocks();
+        enemies.SetSeed(12345);
+        for (int row = ROCK_ROW + 1; row <= SHAFT_BOTTOM; row++) {
+            sf::Vector2f centre = bench::TileCentre(SHAFT_COL, row);
+            map.setTileAt(centre.x, centre.y, TileType::Empty);
+        }
+        for (int row = SHAFT_BOTTOM - 4; row <= SHAFT_BOTTOM; row++) {
+            enemies.SpawnEnemy(EnemyType::POOKA, bench::TileCentre(SHAFT_COL, row));
+        }
+        int spawned = enemies.GetEnemyCount();
+        enemies.SpawnRock(bench::TileCentre(SHAFT_COL, ROCK_ROW), 1);
+        state.ResumeTiming();
+
+        int tick = 0;
+        while (enemies.GetRockCount() > 0 && tick < MAX_TICKS) {
+            enemies.Update(bench::FIXED_TIMESTEP, playerPosition);
+            tick++;
+        }
+        ticks += tick;
+        squashed += spawned - enemies.GetEnemyCount();
+    }
+    state.counters["ticks_per_fall"] = static_cast<double>(ticks) / state.iterations();
+    state.counters["squashed_per_fall"] = static_cast<double>(squashed) / state.iterations();
+    state.SetItemsProcessed(ticks);
+}
+BENCHMARK(BM_RockFallAndSquash);
@@ -0,0 +1,52 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> totalAllocations{ 0 };
+    thread_local uint64_t threadAllocations = 0;
+
+    void* countedAlloc(std::size_t size) {
+        totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        threadAllocations++;
+        return std::malloc(size == 0 ? 1 : size);
+    }
+}
+
+uint64_t AllocationCounter::Total() {
+    return totalAllocations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::ThisThread() {
+    return threadAllocations;
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = countedAlloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = countedAlloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
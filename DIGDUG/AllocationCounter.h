@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+// Counts calls to the global operator new, which this module replaces.
+// Used to check that hot paths (stage restarts, per-tick updates) stay
+// allocation-free once pools have warmed up. Over-aligned allocations
+// (operator new with std::align_val_t) are not counted.
+class AllocationCounter
+{
+public:
+	// Allocations made by any thread since startup
+	static uint64_t Total();
+	// Allocations made by the calling thread; unaffected by the logger thread
+	static uint64_t ThisThread();
+};
@@ -1,7 +1,7 @@
 #include "Animation.h"
 #include <iostream>
 
-Animation::Animation(sf::Texture* texture, sf::Vector2u imageCount, float switchTime, int sizeX, int sizeY, bool shouldLoop) : sizeX(16), sizeY(16)
+Animation::Animation(sf::Vector2i origin, sf::Vector2u imageCount, float switchTime, int sizeX, int sizeY, bool shouldLoop) : sizeX(16), sizeY(16), origin(origin)
 {
     this->imageCount = imageCount;
     this->switchTime = switchTime;
@@ -19,7 +19,7 @@ Animation::~Animation()
 {
 }
 
-void Animation::Update(int animationRow, float deltaTime, sf::Sprite& sprite)
+void Animation::Update(int animationRow, float deltaTime, GameSprite& sprite)
 {
     currentImage.y = animationRow;
 
@@ -47,7 +47,12 @@ void Animation::Update(int animationRow, float deltaTime, sf::Sprite& sprite)
         // debug     << ", row: " << currentImage.y << ", looping: " << isLooping << std::endl;
     }
 
-    uvRect.position = sf::Vector2i(currentImage.x * uvRect.size.x, currentImage.y * uvRect.size.y);
+    ApplyFrame(sprite);
+}
+
+void Animation::ApplyFrame(GameSprite& sprite)
+{
+    uvRect.position = origin + sf::Vector2i(currentImage.x * uvRect.size.x, currentImage.y * uvRect.size.y);
     sprite.setTextureRect(uvRect);
 }
 
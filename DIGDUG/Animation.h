@@ -1,15 +1,19 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "GameSprite.h"
 class Animation
 {
 public:
 	sf::IntRect uvRect;
 
 public:
-	Animation(sf::Texture* texture, sf::Vector2u imageCount, float switchTime, int sizeX, int sizeY, bool shouldLoop = true);
+	// origin is where the sheet's first frame sits in the texture, e.g. its TextureAtlas offset
+	Animation(sf::Vector2i origin, sf::Vector2u imageCount, float switchTime, int sizeX, int sizeY, bool shouldLoop = true);
 	~Animation();
 
-	void Update(int animationRow, float deltaTime, sf::Sprite& sprite);
+	void Update(int animationRow, float deltaTime, GameSprite& sprite);
+	// Points the sprite at currentImage without advancing time
+	void ApplyFrame(GameSprite& sprite);
 	sf::Vector2u currentImage;
 	sf::Vector2u imageCount;
 
@@ -25,4 +29,6 @@ private:
 
 	int sizeX;
 	int sizeY;
+
+	sf::Vector2i origin;
 };
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "AssetCache.h"
+#include "Log.h"
+#include "Runtime.h"
+
+AssetCache::Table<sf::Texture> AssetCache::textures;
+std::mutex AssetCache::mutex;
+size_t AssetCache::loadCount = 0;
+
+template <typename T>
+std::shared_ptr<const T> AssetCache::get(Table<T>& table, std::string_view path) {
+    if (Runtime::IsHeadless()) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = table.find(path);
+    if (it != table.end()) {
+        return it->second;
+    }
+
+    // Failures are cached as nullptr too, so a missing file is only tried once
+    auto asset = std::make_shared<T>();
+    loadCount++;
+    if (!asset->loadFromFile(path)) {
+        LOG_WARNING("Failed to load asset: " << path);
+        asset = nullptr;
+    }
+    else {
+        LOG_DEBUG("Loaded asset: " << path);
+    }
+    table.emplace(std::string(path), asset);
+    return asset;
+}
+
+std::shared_ptr<const sf::Texture> AssetCache::GetTexture(std::string_view path) {
+    return get(textures, path);
+}
+
+void AssetCache::ReleaseUnused() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::erase_if(textures, [](const auto& entry) { return entry.second && entry.second.use_count() == 1; });
+}
+
+size_t AssetCache::GetLoadCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return loadCount;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Process-wide cache of decoded textures keyed by file path.
+// Each asset is decoded and uploaded once; callers share it through shared_ptr.
+// Entries stay resident across stage transitions until ReleaseUnused() drops the
+// ones nobody else holds. In headless mode nothing is loaded and nullptr is returned.
+class AssetCache
+{
+public:
+	static std::shared_ptr<const sf::Texture> GetTexture(std::string_view path);
+
+	static void ReleaseUnused();
+	// Number of file decodes performed so far
+	static size_t GetLoadCount();
+
+private:
+	// Transparent hashing lets lookups take a string_view, so cache hits never build a std::string
+	struct PathHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view path) const { return std::hash<std::string_view>{}(path); }
+	};
+
+	template <typename T>
+	using Table = std::unordered_map<std::string, std::shared_ptr<const T>, PathHash, std::equal_to<>>;
+
+	template <typename T>
+	static std::shared_ptr<const T> get(Table<T>& table, std::string_view path);
+
+	static Table<sf::Texture> textures;
+	static std::mutex mutex;
+	static size_t loadCount;
+};
@@ -1,16 +1,17 @@
 #include "EnemyManager.h"
-#include <iostream>
+#include "Log.h"
 #include <algorithm>
 #include <cmath>
 #include "Player.h"
-#include "Pooka.h"
 #include "Rock.h"
 #include "GameState.h"
+#include "Profiler.h"
 
 EnemyManager::EnemyManager(Map* map, Player* player, int maxEnemyCount)
-    : gameMap(map), player(player), maxEnemies(maxEnemyCount), currentEnemyCount(0) {
-    enemies.reserve(maxEnemies);
-    rocks.reserve(10);
+    : gameMap(map), player(player), pookas(map, player, &rng), activeRocks(0), maxEnemies(maxEnemyCount), currentEnemyCount(0), enemyGridDirty(true) {
+    pookas.Reserve(maxEnemies);
+    rocks.reserve(MAX_ROCKS);
+    rockSlots.Reserve(MAX_ROCKS);
 }
 
 EnemyManager::~EnemyManager() {
@@ -19,26 +20,24 @@ EnemyManager::~EnemyManager() {
 }
 
 void EnemyManager::Initialise() {
-    std::cout << "EnemyManager initialized" << '\n';
+    pookas.Load();
+    LOG_INFO("EnemyManager initialized");
 }
 
 void EnemyManager::Update(float deltaTime, sf::Vector2f playerPosition) {
+    PROFILE_SCOPE("EnemyManager::Update");
     States currentState = gameState->getGameState();
 
     // Only update enemies and rocks during GAME state
     if (currentState == States::GAME) {
-        for (auto& enemy : enemies) {
-            if (enemy && enemy->isActive()) {
-                enemy->Update(deltaTime, playerPosition);
-            }
-        }
+        chaseField.Update(*gameMap, playerPosition);
+        pookas.Update(deltaTime, playerPosition, chaseField);
+        enemyGridDirty = true;
 
         // Update ALL rocks, not just active ones
         // Rocks need to update even when !isActive() to handle destroy animation
-        for (auto& rock : rocks) {
-            if (rock) {  // Only check if rock exists, not if it's active
-                rock->Update(deltaTime, playerPosition);
-            }
+        for (size_t i = 0; i < activeRocks; i++) {
+            rocks[i]->Update(deltaTime, playerPosition);  // Not gated on isActive()
         }
 
         CheckCollisionWithPlayer(playerPosition, { 16,16 });
@@ -49,20 +48,18 @@ void EnemyManager::Update(float deltaTime, sf::Vector2f playerPosition) {
 }
 
 void EnemyManager::Draw(sf::RenderWindow& window) {
+    PROFILE_SCOPE("EnemyManager::Draw");
     States currentState = gameState->getGameState();
 
     // Draw enemies and rocks during GAME, START, and LOSS states CHANGE THIS IF YOU WANT TO HAVE IT NOT DRAW STUFF DURING A GAMESTATE
     if (currentState == States::GAME || currentState == States::START || currentState == States::LOSS) {
-        for (auto& enemy : enemies) {
-            if (enemy && enemy->isActive()) {
-                enemy->Draw(window);
-            }
-        }
-        for (auto& rock : rocks) {
-            if (rock && rock->isActive()) {
+        pookas.Draw(window);
+        for (size_t i = 0; i < activeRocks; i++) {
+            const auto& rock = rocks[i];
+            if (rock->isActive()) {
                 rock->Draw(window);
             }
-            else if (rock && !rock->isActive() && !rock->getDestroyAnimationComplete() && !rock->isMarkedForDeletion()) {
+            else if (!rock->getDestroyAnimationComplete() && !rock->isMarkedForDeletion()) {
                 rock->Draw(window);
             }
         }
@@ -87,163 +84,201 @@ void EnemyManager::SpawnRocksFromMap() {
     }
 }
 
-void EnemyManager::SpawnRock(sf::Vector2f position, int textureIndex) {
-    auto rock = std::make_shared<Rock>(gameMap, this, player, position, sf::Vector2i(0, 0));
-    rock->setTextureIndex(textureIndex);
-    rock->Initialise();
-    rock->Load();
-    rock->setPosition(position);
-    rocks.push_back(rock);
-    std::cout << "Spawned Rock at position (" << position.x << ", " << position.y << ") with texture index " << textureIndex << '\n';
+EntityID EnemyManager::SpawnRock(sf::Vector2f position, int textureIndex) {
+    if (activeRocks >= MAX_ROCKS) {
+        LOG_WARNING("Cannot spawn rock: pool is full (" << MAX_ROCKS << ")");
+        return INVALID_ENTITY;
+    }
+    if (activeRocks == rocks.size()) {
+        // Pool warm-up: only the first time this many rocks are alive at once
+        rocks.push_back(std::make_unique<Rock>(gameMap, this, player, position, sf::Vector2i(0, 0)));
+    }
+    Rock& rock = *rocks[activeRocks++];
+    rock.Reset(position, textureIndex);
+    rock.Initialise();
+    rock.Load();
+    rock.setPosition(position);
+    LOG_DEBUG("Spawned Rock at position (" << position.x << ", " << position.y << ") with texture index " << textureIndex);
+    return rockSlots.Add();
 }
 
 void EnemyManager::SpawnEnemy(EnemyType type, sf::Vector2f position) {
     if (GetEnemyCount() >= maxEnemies) {
-        std::cout << "Cannot spawn enemy: max enemy limit reached (" << maxEnemies << ")" << '\n';
+        LOG_WARNING("Cannot spawn enemy: max enemy limit reached (" << maxEnemies << ")");
         return;
     }
-    std::shared_ptr<Entity> newEnemy = nullptr;
     switch (type) {
     case EnemyType::POOKA: {
-        auto pooka = std::make_shared<Pooka>(gameMap, player);
-        pooka->Initialise();
-        pooka->Load();
-        pooka->setPosition(position);
-        newEnemy = pooka;
-        std::cout << "Spawned Pooka at position (" << position.x << ", " << position.y << ")" << '\n';
+        pookas.Spawn(position);
+        currentEnemyCount++;
+        enemyGridDirty = true;
+        LOG_DEBUG("Spawned Pooka at position (" << position.x << ", " << position.y << ")");
         break;
     }
     case EnemyType::FYGAR: {
-        std::cout << "Fygar spawning not implemented yet!" << '\n';
+        LOG_WARNING("Fygar spawning not implemented yet!");
         return;
     }
     default:
-        std::cout << "Unknown enemy type!" << '\n';
+        LOG_WARNING("Unknown enemy type!");
         return;
     }
-    if (newEnemy) {
-        enemies.push_back(newEnemy);
-        currentEnemyCount++;
-    }
 }
 
 void EnemyManager::RemoveDeadEnemies() {
-    size_t initialCount = enemies.size();
-    auto removedCount = std::remove_if(enemies.begin(), enemies.end(),
-        [](const std::shared_ptr<Entity>& enemy) {
-            if (!enemy) {
-                std::cout << "Removing null enemy" << std::endl;
-                return true;
-            }
-            if (!enemy->isActive()) {
-                std::cout << "Removing dead enemy" << std::endl;
-                return true;
-            }
-            return false;
-        });
-    enemies.erase(removedCount, enemies.end());
-    currentEnemyCount = static_cast<int>(enemies.size());
-    if (enemies.size() != initialCount) {
-        std::cout << "Removed " << (initialCount - enemies.size()) << " dead enemies. Current count: " << currentEnemyCount << std::endl;
+    PROFILE_SCOPE("EnemyManager::RemoveDeadEnemies");
+    size_t removed = pookas.RemoveDead();
+    currentEnemyCount = static_cast<int>(pookas.Size());
+    if (removed > 0) {
+        enemyGridDirty = true;
+        LOG_DEBUG("Removed " << removed << " dead enemies. Current count: " << currentEnemyCount);
     }
 }
 
 void EnemyManager::RemoveDestroyedRocks() {
-    size_t initialCount = rocks.size();
-    auto removedCount = std::remove_if(rocks.begin(), rocks.end(),
-        [](const std::shared_ptr<Rock>& rock) {
-            if (!rock) {
-                std::cout << "Removing null rock" << std::endl;
-                return true;
-            }
-            // Remove rocks that are marked for deletion OR have completed their destroy animation
-            if (rock->isMarkedForDeletion() || (!rock->isActive() && rock->getDestroyAnimationComplete())) {
-                std::cout << "Removing destroyed rock after animation completed" << std::endl;
-                return true;
-            }
-            return false;
-        });
-    rocks.erase(removedCount, rocks.end());
-    if (rocks.size() != initialCount) {
-        std::cout << "Removed " << (initialCount - rocks.size()) << " destroyed rocks. Current count: " << rocks.size() << std::endl;
+    size_t initialCount = activeRocks;
+    for (size_t i = 0; i < activeRocks;) {
+        // Remove rocks that are marked for deletion OR have completed their destroy animation
+        const Rock& rock = *rocks[i];
+        if (rock.isMarkedForDeletion() || (!rock.isActive() && rock.getDestroyAnimationComplete())) {
+            LOG_DEBUG("Removing destroyed rock after animation completed");
+            RemoveRockAt(i);
+        }
+        else {
+            i++;
+        }
+    }
+    if (activeRocks != initialCount) {
+        LOG_DEBUG("Removed " << (initialCount - activeRocks) << " destroyed rocks. Current count: " << activeRocks);
     }
 }
 
-void EnemyManager::RemoveRock(std::shared_ptr<Rock> rock) {
-    if (!rock) {
-        std::cout << "Attempted to remove null rock" << std::endl;
+void EnemyManager::RemoveRockAt(size_t index) {
+    rockSlots.RemoveAt(index);
+    // The removed rock goes back to the spare end of the pool
+    std::swap(rocks[index], rocks[activeRocks - 1]);
+    activeRocks--;
+}
+
+void EnemyManager::RemoveRock(EntityID rock) {
+    int index = rockSlots.IndexOf(rock);
+    if (index < 0) {
+        LOG_WARNING("Failed to remove rock: stale or invalid handle " << rock);
         return;
     }
-    size_t initialCount = rocks.size();
-    auto removedCount = std::remove_if(rocks.begin(), rocks.end(),
-        [&rock](const std::shared_ptr<Rock>& r) {
-            if (r == rock) {
-                std::cout << "Removing specific rock at position (" << r->getPosition().x << ", " << r->getPosition().y << ")" << std::endl;
-                return true;
-            }
-            return false;
-        });
-    rocks.erase(removedCount, rocks.end());
-    if (rocks.size() != initialCount) {
-        std::cout << "Removed 1 rock. Current count: " << rocks.size() << std::endl;
-    }
-    else {
-        std::cout << "Failed to remove rock: not found in rocks vector" << std::endl;
-    }
+    LOG_DEBUG("Removing specific rock at position (" << rocks[index]->getPosition().x << ", " << rocks[index]->getPosition().y << ")");
+    RemoveRockAt(index);
 }
 
 void EnemyManager::ClearAllEnemies() {
-    enemies.clear();
+    pookas.Clear();
     currentEnemyCount = 0;
+    enemyGridDirty = true;
 }
 
 void EnemyManager::ClearAllRocks() {
-    rocks.clear();
+    activeRocks = 0;
+    rockSlots.Clear();
 }
 
-std::shared_ptr<Entity> EnemyManager::CheckCollisionWithPlayer(sf::Vector2f playerPosition, sf::Vector2f playerSize) {
+EntityID EnemyManager::CheckCollisionWithPlayer(sf::Vector2f playerPosition, sf::Vector2f playerSize) {
     sf::FloatRect playerBounds;
     playerBounds.position = sf::Vector2f(
         playerPosition.x - playerSize.x / 2.0f,
         playerPosition.y - playerSize.y / 2.0f
     );
     playerBounds.size = playerSize;
-    for (auto& enemy : enemies) {
-        if (enemy && enemy->isActive()) {
-            sf::FloatRect enemyBounds = enemy->getBounds();
-            if (playerBounds.findIntersection(enemyBounds)) {
-                std::cout << "Enemy collided with player" << '\n';
-                HandleEnemyCollisions(enemy);
-                return enemy;
-            }
-        }
+    QueryEnemyIndices(playerBounds, gridHits);
+    if (gridHits.empty()) {
+        return INVALID_ENTITY;
     }
-    return nullptr;
+    LOG_DEBUG("Enemy collided with player");
+    HandleEnemyCollisions(gridHits.front());
+    return pookas.GetID(gridHits.front());
 }
 
-void EnemyManager::HandleEnemyCollisions(std::shared_ptr<Entity> collidedEnemy) {
-    if (collidedEnemy && collidedEnemy->getInflationStatus() == false) {
+void EnemyManager::HandleEnemyCollisions(size_t collidedEnemy) {
+    if (!pookas.IsInflated(collidedEnemy)) {
         player->setHealth(0);
-        std::cout << "Player killed by enemy collision!" << std::endl;
+        LOG_INFO("Player killed by enemy collision!");
     }
 }
 
-void EnemyManager::KillEnemy(std::shared_ptr<Entity> enemy) {
-    if (enemy) {
-        enemy->setActive(false);
-        std::cout << "Enemy killed!" << std::endl;
+void EnemyManager::KillEnemy(EntityID enemy) {
+    int index = pookas.Find(enemy);
+    if (index >= 0) {
+        pookas.Kill(index);
+        LOG_DEBUG("Enemy killed!");
     }
 }
 
 void EnemyManager::KillAllEnemiesAt(sf::Vector2f position, float radius) {
     sf::FloatRect killZone({ position.x - radius, position.y - radius }, { radius * 2, radius * 2 });
-    for (auto& enemy : enemies) {
-        if (enemy && enemy->isActive()) {
-            sf::FloatRect enemyBounds = enemy->getBounds();
-            if (killZone.findIntersection(enemyBounds)) {
-                enemy->setActive(false);
-                std::cout << "Enemy killed by external force at position (" << position.x << ", " << position.y << ")" << std::endl;
-            }
+    QueryEnemyIndices(killZone, gridHits);
+    for (uint32_t index : gridHits) {
+        pookas.Kill(index);
+        LOG_DEBUG("Enemy killed by external force at position (" << position.x << ", " << position.y << ")");
+    }
+}
+
+void EnemyManager::RebuildEnemyGrid() {
+    sf::Vector2i gridSize = gameMap->getGridSize();
+    int tilesPerCell = (std::max(gridSize.x, gridSize.y) + MAX_GRID_SIDE - 1) / MAX_GRID_SIDE;
+    enemyGrid.Reset((gridSize.x + tilesPerCell - 1) / tilesPerCell, (gridSize.y + tilesPerCell - 1) / tilesPerCell,
+                    static_cast<float>(gameMap->getTileSize() * tilesPerCell));
+    for (size_t i = 0; i < pookas.Size(); i++) {
+        if (pookas.IsAlive(i)) {
+            enemyGrid.Insert(static_cast<uint32_t>(i), pookas.GetBounds(i));
+        }
+    }
+    enemyGrid.Finish();
+    enemyGridDirty = false;
+}
+
+void EnemyManager::QueryEnemyIndices(const sf::FloatRect& area, std::vector<uint32_t>& hits) {
+    hits.clear();
+    if (enemyGridDirty) {
+        RebuildEnemyGrid();
+    }
+    enemyGrid.Query(area, gridCandidates);
+    // Candidates come back in index order, so the first hit matches what a linear scan would find
+    for (uint32_t index : gridCandidates) {
+        if (pookas.IsAlive(index) && area.findIntersection(pookas.GetBounds(index))) {
+            hits.push_back(index);
         }
     }
+}
+
+void EnemyManager::QueryEnemies(const sf::FloatRect& area, std::vector<EntityID>& hits) {
+    QueryEnemyIndices(area, gridHits);
+    hits.clear();
+    for (uint32_t index : gridHits) {
+        hits.push_back(pookas.GetID(index));
+    }
+}
+
+void EnemyManager::AttachHarpoon(EntityID enemy) {
+    int index = pookas.Find(enemy);
+    if (index >= 0) {
+        pookas.AttachHarpoon(index);
+    }
+}
+
+void EnemyManager::InflateEnemy(EntityID enemy) {
+    int index = pookas.Find(enemy);
+    if (index >= 0) {
+        pookas.Inflate(index);
+    }
+    else if (player != nullptr) {
+        // The enemy was removed under the harpoon (e.g. crushed by a rock); let go of it
+        player->DetachHarpoon();
+    }
+}
+
+std::optional<sf::FloatRect> EnemyManager::GetEnemyBounds(EntityID enemy) const {
+    int index = pookas.Find(enemy);
+    if (index < 0) {
+        return std::nullopt;
+    }
+    return pookas.GetBounds(index);
 }
\ No newline at end of file
@@ -1,6 +1,11 @@
 #pragma once
 #include "Entity.h"
 #include "Map.h"
+#include "Random.h"
+#include "SpatialGrid.h"
+#include "FlowField.h"
+#include "Pooka.h"
+#include <optional>
 #include <vector>
 #include <memory>
 
@@ -17,16 +22,38 @@ class EnemyManager {
 private:
     Map* gameMap;
     Player* player;
-    std::vector<std::shared_ptr<Entity>> enemies;
-    std::vector<std::shared_ptr<Rock>> rocks;
+    PookaStore pookas;
+    // Fixed-capacity rock pool: [0, activeRocks) are live and densely packed, the
+    // rest are spare objects kept constructed so later stages reuse them
+    static const int MAX_ROCKS = 32;
+    std::vector<std::unique_ptr<Rock>> rocks;
+    size_t activeRocks;
+    SlotMap rockSlots;
     int maxEnemies;
     int currentEnemyCount;
     GameState* gameState;
+    Random rng;   // Shared by all enemies; reseeded per stage via SetSeed
+
+    // Tile-aligned broadphase over enemies, indexed by dense position in `pookas`.
+    // Rebuilt lazily whenever enemies have moved, spawned or been removed. On large
+    // maps cells span several tiles so a rebuild never walks more than
+    // MAX_GRID_SIDE^2 cells.
+    static const int MAX_GRID_SIDE = 64;
+    SpatialGrid enemyGrid;
+    bool enemyGridDirty;
+    std::vector<uint32_t> gridCandidates;
+    std::vector<uint32_t> gridHits;   // Scratch for the collision queries below, reused every tick
+
+    // Tunnel distances to the player, shared by every chasing Pooka
+    FlowField chaseField;
 
     void RemoveDeadEnemies();
     void RemoveDestroyedRocks();
-    std::shared_ptr<Entity> CheckCollisionWithPlayer(sf::Vector2f playerPosition, sf::Vector2f playerSize);
-    void HandleEnemyCollisions(std::shared_ptr<Entity> collidedEnemy);
+    void RemoveRockAt(size_t index);
+    EntityID CheckCollisionWithPlayer(sf::Vector2f playerPosition, sf::Vector2f playerSize);
+    void HandleEnemyCollisions(size_t collidedEnemy);
+    void RebuildEnemyGrid();
+    void QueryEnemyIndices(const sf::FloatRect& area, std::vector<uint32_t>& hits);
 
 public:
     EnemyManager(Map* map, Player* player, int maxEnemyCount);
@@ -39,18 +66,26 @@ public:
     void SpawnEnemiesFromMap();
     void SpawnRocksFromMap();
     void SpawnEnemy(EnemyType type, sf::Vector2f position);
-    void SpawnRock(sf::Vector2f position, int textureIndex);
+    EntityID SpawnRock(sf::Vector2f position, int textureIndex);
 
     void ClearAllEnemies();
     void ClearAllRocks();
 
-    void KillEnemy(std::shared_ptr<Entity> enemy);
+    void KillEnemy(EntityID enemy);
     void KillAllEnemiesAt(sf::Vector2f position, float radius);
 
-    void RemoveRock(std::shared_ptr<Rock> rock);
+    void RemoveRock(EntityID rock);
+
+    // Active enemies whose bounds intersect the area, in storage order
+    void QueryEnemies(const sf::FloatRect& area, std::vector<EntityID>& hits);
+
+    // Harpoon interaction; enemies are addressed by id since storage indices move on removal
+    void AttachHarpoon(EntityID enemy);
+    void InflateEnemy(EntityID enemy);
+    std::optional<sf::FloatRect> GetEnemyBounds(EntityID enemy) const;
 
-    const std::vector<std::shared_ptr<Entity>>& GetEnemies() const { return enemies; }
-    const std::vector<std::shared_ptr<Rock>>& GetRocks() const { return rocks; }
     int GetEnemyCount() const { return currentEnemyCount; }
+    int GetRockCount() const { return static_cast<int>(activeRocks); }
     void SetGameState(GameState* gs) { gameState = gs; }
+    void SetSeed(uint64_t seed) { rng.Seed(seed); }
 };
\ No newline at end of file
@@ -1,11 +1,9 @@
 #include "Entity.h"
+#include "Log.h"
 #include "Map.h"
 #include "SFX.h"
-#include <iostream>
 #include <cmath>
 
-EntityID Entity::nextID = 0;
-
 Entity::Entity(EntityType t, bool alive, sf::Vector2i size)
     : type(t), isAlive(alive), size(size), isMoving(false), targetPosition(0, 0) {
     hitbox.setSize(sf::Vector2f(size.x -6, size.y-6));
@@ -15,7 +13,7 @@ Entity::Entity(EntityType t, bool alive, sf::Vector2i size)
 }
 
 Entity::~Entity() {
-    std::cout << "Entity id: " << static_cast<int>(type) << " has been destroyed..." << '\n';
+    LOG_DEBUG("Entity id: " << static_cast<int>(type) << " has been destroyed...");
 }
 
 void Entity::Initialise() {
@@ -30,11 +28,11 @@ bool Entity::canMoveTo(sf::Vector2f position, Map* map) const {
         position.y < 0 || position.y >= mapSize.y) {
         return false;
     }
-    int tileType = map->getTileAt(position.x, position.y);
-    return (tileType == 0 || tileType == 2 || tileType == 3 || tileType == 4);
+    TileType tileType = map->getTileAt(position.x, position.y);
+    return (tileType == TileType::Empty || tileType == TileType::Dirt1 || tileType == TileType::Dirt2 || tileType == TileType::Dirt3);
 }
 
-void Entity::move(float deltaTime, float speed, sf::Sprite& sprite) {
+void Entity::move(float deltaTime, float speed, GameSprite& sprite) {
     if (!isMoving) return;
 
     sf::Vector2f currentPosition = sprite.getPosition();
@@ -81,7 +79,7 @@ sf::FloatRect Entity::getBounds() const {
     return hitbox.getGlobalBounds();
 }
 
-void Entity::handleCollision(std::shared_ptr<Entity> other) {
+void Entity::handleCollision(Entity& other) {
     // Base implementation
 }
 
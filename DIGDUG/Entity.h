@@ -3,6 +3,7 @@
 #include <memory>
 #include "Animation.h"
 
+// Generational handle (slot index + generation) issued by a SlotMap
 using EntityID = uint32_t;
 constexpr EntityID INVALID_ENTITY = 0;
 
@@ -18,11 +19,11 @@ protected:
     sf::Vector2i size;
     bool isMoving;
     sf::Vector2f targetPosition;
-    const int TILE_SIZE = 16;
+    static constexpr int TILE_SIZE = 16;
     std::unique_ptr<Animation> animation;
 
     virtual bool canMoveTo(sf::Vector2f position, Map* map) const;
-    void move(float deltaTime, float speed, sf::Sprite& sprite);
+    void move(float deltaTime, float speed, GameSprite& sprite);
 
 public:
     Entity(EntityType t, bool alive, sf::Vector2i size);
@@ -32,7 +33,7 @@ public:
     virtual void Load() = 0;
     virtual void Update(float deltaTime, sf::Vector2f playerPosition) = 0;
     virtual void Draw(sf::RenderWindow& window) = 0;
-    virtual void handleCollision(std::shared_ptr<Entity> other);
+    virtual void handleCollision(Entity& other);
     virtual void AttachHarpoon();
     virtual void DetachHarpoon();
     virtual void Inflate();
@@ -48,7 +49,5 @@ public:
     bool isActive() const { return isAlive; }
     void setActive(bool y) {isAlive = y; }
 
-    static EntityID nextID;
-    static EntityID CreateEntity() { return ++nextID; }
     static bool IsValid(EntityID entity) { return entity != INVALID_ENTITY; }
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "FlowField.h"
+#include "Map.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+void FlowField::Update(const Map& map, sf::Vector2f targetPosition) {
+    tileSize = Map::getTileSize();
+    sf::Vector2i grid = map.getGridSize();
+    sf::Vector2i cell(static_cast<int>(std::floor(targetPosition.x / tileSize)),
+                      static_cast<int>(std::floor(targetPosition.y / tileSize)));
+
+    if (valid && cell == targetCell && map.getRevision() == mapRevision &&
+        grid.x == columns && grid.y == rows) {
+        return;
+    }
+    columns = grid.x;
+    rows = grid.y;
+    targetCell = cell;
+    mapRevision = map.getRevision();
+    rebuild(map);
+    valid = true;
+}
+
+int FlowField::cellAt(sf::Vector2f position) const {
+    int col = static_cast<int>(std::floor(position.x / tileSize));
+    int row = static_cast<int>(std::floor(position.y / tileSize));
+    if (col < 0 || col >= columns || row < 0 || row >= rows) {
+        return -1;
+    }
+    return row * columns + col;
+}
+
+void FlowField::rebuild(const Map& map) {
+    PROFILE_SCOPE("FlowField::rebuild");
+    buildCount++;
+    const size_t cellCount = static_cast<size_t>(columns) * rows;
+    if (distance.size() == cellCount) {
+        // Only the cells the last build reached were written; on a large map with small
+        // tunnels that is far cheaper than clearing the whole grid
+        for (int cell : queue) {
+            distance[cell] = UNREACHABLE;
+            step[cell] = NONE;
+        }
+    }
+    else {
+        distance.assign(cellCount, UNREACHABLE);
+        step.assign(cellCount, NONE);
+    }
+    queue.clear();
+
+    if (targetCell.x < 0 || targetCell.x >= columns || targetCell.y < 0 || targetCell.y >= rows) {
+        return;   // Target is off the map (e.g. during the intro walk-in)
+    }
+
+    // The target's own tile is always a valid goal, even if it is still dirt
+    int start = targetCell.y * columns + targetCell.x;
+    distance[start] = 0;
+    queue.push_back(start);
+
+    // Neighbour order matches the old greedy chase: vertical moves preferred
+    static const int dx[4] = { 0, 0, -1, 1 };
+    static const int dy[4] = { -1, 1, 0, 0 };
+    // Step a chaser in the neighbour takes to come back to the current cell
+    static const Step back[4] = { DOWN, UP, RIGHT, LEFT };
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int current = queue[head];
+        int col = current % columns;
+        int row = current / columns;
+        for (int d = 0; d < 4; d++) {
+            int nc = col + dx[d];
+            int nr = row + dy[d];
+            if (nc < 0 || nc >= columns || nr < 0 || nr >= rows) {
+                continue;
+            }
+            int next = nr * columns + nc;
+            if (distance[next] != UNREACHABLE || map.getTileAtGrid(nc, nr) != TileType::Empty) {
+                continue;
+            }
+            // Saturates on very large maps; only the step direction matters for chasing
+            distance[next] = static_cast<uint16_t>(std::min(distance[current] + 1, UNREACHABLE - 1));
+            step[next] = back[d];
+            queue.push_back(next);
+        }
+    }
+}
+
+uint16_t FlowField::DistanceAt(sf::Vector2f position) const {
+    int cell = cellAt(position);
+    return (cell < 0 || distance.empty()) ? UNREACHABLE : distance[cell];
+}
+
+sf::Vector2i FlowField::StepFrom(sf::Vector2f position) const {
+    int cell = cellAt(position);
+    if (cell < 0 || step.empty()) {
+        return { 0, 0 };
+    }
+    switch (step[cell]) {
+    case UP:    return { 0, -1 };
+    case DOWN:  return { 0, 1 };
+    case LEFT:  return { -1, 0 };
+    case RIGHT: return { 1, 0 };
+    default:    return { 0, 0 };
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+// Breadth-first distance field over the open tunnels of a Map, rooted at one
+// target tile (the player). Every reachable cell stores the step that moves one
+// tile closer to the target, so any number of chasers read their next move in
+// O(1). Rebuilt only when the target tile or the map's tiles change.
+class FlowField
+{
+public:
+    static constexpr uint16_t UNREACHABLE = 0xFFFF;
+
+    // Recomputes the field if the target moved to another tile or the map changed
+    void Update(const Map& map, sf::Vector2f targetPosition);
+
+    // Tunnel distance in tiles from the cell containing `position`, or UNREACHABLE
+    uint16_t DistanceAt(sf::Vector2f position) const;
+    bool IsReachable(sf::Vector2f position) const { return DistanceAt(position) != UNREACHABLE; }
+    // Unit grid step towards the target, or (0, 0) when unreachable or already there
+    sf::Vector2i StepFrom(sf::Vector2f position) const;
+
+    // Number of times the field has actually been recomputed
+    uint32_t GetBuildCount() const { return buildCount; }
+
+private:
+    enum Step : uint8_t { NONE, UP, DOWN, LEFT, RIGHT };
+
+    int cellAt(sf::Vector2f position) const;
+    void rebuild(const Map& map);
+
+    int columns = 0;
+    int rows = 0;
+    int tileSize = 1;
+    sf::Vector2i targetCell{ -1, -1 };
+    uint32_t mapRevision = 0;
+    bool valid = false;
+    uint32_t buildCount = 0;
+
+    std::vector<uint16_t> distance;
+    std::vector<uint8_t> step;
+    std::vector<int> queue;   // Reused between builds
+};
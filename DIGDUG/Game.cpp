@@ -0,0 +1,398 @@
+#include "Game.h"
+#include "Log.h"
+#include "AssetCache.h"
+#include "AllocationCounter.h"
+#include "Runtime.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Camera position along one axis: follows the target but never shows past the
+    // world's edges. Worlds no wider than the view stay pinned to the origin.
+    float followAxis(float target, float viewSize, float worldSize) {
+        float half = viewSize / 2.0f;
+        if (worldSize <= viewSize) {
+            return half;
+        }
+        return std::clamp(target, half, worldSize - half);
+    }
+}
+
+Game::Game(uint64_t seed) : stageManager("Assets/Map/"), player(&map), enemyManager(&map, &player, 10),
+victory("Assets/Sounds/Music/success.mp3"),
+lossMusic("Assets/Sounds/Music/loss.mp3", SFX::Type::MUSIC),
+noLivesMusic("Assets/Sounds/Music/nolivesleft.mp3", SFX::Type::MUSIC),
+startMusic("Assets/Sounds/Music/start_music.mp3", SFX::Type::MUSIC), seed(seed)
+{
+    victory.setVolume(30);
+    startMusic.setLoop(false); lossMusic.setLoop(false); noLivesMusic.setLoop(false);
+    startMusic.setVolume(35); lossMusic.setVolume(35); noLivesMusic.setVolume(35);
+
+    gameState.setGameState(States::START);
+    player.SetGameState(&gameState);
+    enemyManager.SetGameState(&gameState);
+    player.SetEnemyManager(&enemyManager);
+}
+
+bool Game::Initialise() {
+    // Load initial map using StageManager
+    std::unique_ptr<Map::Stage> stage = stageManager.takeStage(stageManager.getCurrentStage());
+    if (stage) {
+        map.swapStage(*stage);
+    }
+    else {
+        LOG_ERROR("No maps available!");
+        return false;
+    }
+
+    player.Initialise();
+    enemyManager.Initialise();
+
+    const auto& spawns = map.getEntitySpawns();
+    for (const auto& spawn : spawns) {
+        if (spawn.first == '*') {
+            startPos = spawn.second;
+            break;
+        }
+    }
+    calculateStartSteps();
+
+    player.setPlayerInitialPosition(initialPos);
+    player.SetCreateTunnels(false);
+    player.Load();
+
+    enemyManager.SetSeed(Random::Combine(seed, 0));
+    enemyManager.SpawnEnemiesFromMap();
+    enemyManager.SpawnRocksFromMap();
+    map.printInfo();
+    startMusic.play();
+    stagesPlayed = 1;
+    // Prepare the following stage while this one is played
+    stageManager.prefetch(stageManager.getNextStage());
+    return true;
+}
+
+int Game::Advance(float frameTime) {
+    // Consume real time in fixed simulation steps so behaviour does not depend on
+    // frame rate; the remainder carries over to the next frame
+    accumulator += frameTime * timeScale;
+    int steps = 0;
+    while (accumulator >= FIXED_TIMESTEP && steps < MAX_STEPS_PER_ADVANCE) {
+        Update(FIXED_TIMESTEP);
+        accumulator -= FIXED_TIMESTEP;
+        steps++;
+    }
+    if (steps == MAX_STEPS_PER_ADVANCE && accumulator >= FIXED_TIMESTEP) {
+        // Too far behind to catch up; drop the backlog instead of spiralling
+        accumulator = 0.0f;
+    }
+    return steps;
+}
+
+void Game::Update(float deltaTime) {
+    PROFILE_SCOPE("Game::Update");
+    player.SetInput(pollInput());
+
+    switch (gameState.getGameState())
+    {
+    case States::START:
+        updateStartState(deltaTime);
+        break;
+    case States::GAME:
+        updateGameState(deltaTime);
+        break;
+    case States::WIN:
+        updateWinState(deltaTime);
+        break;
+    case States::LOSS:
+        updateLossState(deltaTime);
+        break;
+    }
+}
+
+bool Game::StartReplay(const std::string& filename) {
+    if (!replay.Open(filename)) {
+        return false;
+    }
+    seed = replay.GetSeed();
+    replaying = true;
+    return true;
+}
+
+InputState Game::pollInput() {
+    // Every tick produces exactly one input, whatever the game state, so a
+    // recording lines up tick for tick with the simulation it came from
+    InputState state;
+    if (replaying) {
+        replay.Next(state);
+    }
+    else if (!Runtime::IsHeadless()) {
+        state = InputState::FromKeyboard();
+    }
+    recorder.Record(state);
+    return state;
+}
+
+void Game::Draw(sf::RenderWindow& window) {
+    PROFILE_SCOPE("Game::Draw");
+    // Blend sprites between the last two simulation steps by the unsimulated remainder
+    GameSprite::SetInterpolationAlpha(interpolate ? accumulator / FIXED_TIMESTEP : 1.0f);
+
+    // Scrolling camera over the world; the HUD drawn after this goes back to screen space
+    sf::View camera = window.getDefaultView();
+    sf::Vector2f target = player.getDrawPosition();
+    sf::Vector2i worldSize = map.getMapSize();
+    camera.setCenter(sf::Vector2f(followAxis(target.x, camera.getSize().x, static_cast<float>(worldSize.x)),
+                                  followAxis(target.y, camera.getSize().y, static_cast<float>(worldSize.y))));
+    window.setView(camera);
+    map.draw(window);
+    player.Draw(window);
+    enemyManager.Draw(window);
+    window.setView(window.getDefaultView());
+}
+
+void Game::updateStartState(float deltaTime) {
+    // Initialize start scene on first entry
+    if (!startSceneInitialized) {
+        // Recalculate steps in case map changed
+        calculateStartSteps();
+
+        // Fully reset player position
+        player.setPosition(initialPos);
+        player.setPlayerInitialPosition(initialPos);
+        player.setTargetPosition(initialPos);
+        player.setIsMoving(false);
+        player.DetachHarpoon();
+        player.SetCreateTunnels(false);
+        player.setHealth(1); // Reset health
+        startSceneStep = 0;
+        startMovementComplete = false;
+        startSceneInitialized = true;
+        startDelayTimer = 0.0f;
+        startPauseTimer = 0.0f;
+        startPauseComplete = false;
+        movingHorizontally = true;
+        startMusic.play();
+        LOG_DEBUG("START scene initialized: Player reset to (" << initialPos.x << ", " << initialPos.y << ")");
+    }
+
+    startDelayTimer += deltaTime;
+
+    // Handle initial pause
+    if (!startPauseComplete) {
+        startPauseTimer += deltaTime;
+        if (startPauseTimer >= START_PAUSE_DELAY) {
+            startPauseComplete = true;
+            // Set first target based on whether we need horizontal movement
+            if (horizontalSteps > 0) {
+                // Move horizontally first
+                player.setTargetPosition(snapToTileCenter(sf::Vector2f(-16 + TILE_SIZE, 16)));
+                player.SetCreateTunnels(false); // No tunnels on surface
+                movingHorizontally = true;
+                startSceneStep = 1;
+            }
+            else {
+                // Go straight to vertical movement
+                player.setTargetPosition(snapToTileCenter(sf::Vector2f(startPos.x, 32)));
+                player.SetCreateTunnels(true); // Create tunnels when digging
+                movingHorizontally = false;
+                startSceneStep = 1;
+            }
+            LOG_DEBUG("START scene: Pause complete, starting movement");
+        }
+    }
+
+    // Update player movement if pause is complete and movement not yet complete
+    if (startPauseComplete && !startMovementComplete) {
+        player.Update(deltaTime, player.getPlayerPosition());
+
+        // Check if player has reached the current target position
+        if (!player.getIsMoving() && startSceneStep < TOTAL_START_STEPS) {
+            startSceneStep++;
+
+            if (movingHorizontally && startSceneStep <= horizontalSteps) {
+                // Continue horizontal movement
+                float nextX = -16 + startSceneStep * TILE_SIZE;
+                sf::Vector2f nextTarget = snapToTileCenter(sf::Vector2f(nextX, 16));
+                player.setTargetPosition(nextTarget);
+                LOG_DEBUG("START scene: Moving horizontally to (" << nextTarget.x << ", " << nextTarget.y << ")");
+            }
+            else if (movingHorizontally && startSceneStep > horizontalSteps) {
+                // Switch to vertical movement
+                movingHorizontally = false;
+                player.SetCreateTunnels(true); // Enable tunnels for digging
+                float nextY = 16 + (startSceneStep - horizontalSteps) * TILE_SIZE;
+                sf::Vector2f nextTarget = snapToTileCenter(sf::Vector2f(startPos.x, nextY));
+                player.setTargetPosition(nextTarget);
+                LOG_DEBUG("START scene: Starting vertical movement to (" << nextTarget.x << ", " << nextTarget.y << ")");
+            }
+            else if (!movingHorizontally) {
+                // Continue vertical movement
+                float nextY = 16 + (startSceneStep - horizontalSteps) * TILE_SIZE;
+                sf::Vector2f nextTarget = snapToTileCenter(sf::Vector2f(startPos.x, nextY));
+                player.setTargetPosition(nextTarget);
+                LOG_DEBUG("START scene: Moving down to (" << nextTarget.x << ", " << nextTarget.y << ")");
+            }
+        }
+        else if (!player.getIsMoving() && startSceneStep >= TOTAL_START_STEPS) {
+            // Movement complete
+            startMovementComplete = true;
+            sf::Vector2f finalPos = snapToTileCenter(startPos);
+            player.setPosition(finalPos);
+            player.setTargetPosition(finalPos);
+            player.SetCreateTunnels(true);
+            LOG_DEBUG("START scene: Movement complete at (" << finalPos.x << ", " << finalPos.y << ")");
+            player.resetTransform();
+        }
+    }
+
+    if (startDelayTimer >= START_DELAY) {
+        gameState.setGameState(States::GAME);
+        startMusic.stop();
+        startSceneInitialized = false;
+        LOG_INFO("Transitioning to GAME state");
+    }
+}
+
+void Game::updateGameState(float deltaTime) {
+    player.Update(deltaTime, player.getPlayerPosition());
+    enemyManager.Update(deltaTime, player.getPlayerPosition());
+    if (enemyManager.GetEnemyCount() == 0)
+    {
+        gameState.setGameState(States::WIN);
+        victory.play();
+        winDelayTimer = 0.0f;
+        LOG_INFO("All enemies defeated! Transitioning to WIN state");
+    }
+    if (player.getHealth() <= 0)
+    {
+        gameState.setGameState(States::LOSS);
+        lossDelayTimer = 0.0f;
+        lossSceneInitialized = false;
+        LOG_INFO("Player died! Transitioning to LOSS state");
+    }
+}
+
+void Game::updateWinState(float deltaTime) {
+    winDelayTimer += deltaTime;
+    player.Update(deltaTime, player.getPlayerPosition());
+    player.resetTransform();
+    if (winDelayTimer >= WIN_DELAY)
+    {
+        // Advance to next stage
+        stageManager.incrementStage();
+        loadStage(stageManager.getCurrentStage());
+
+        gameState.setGameState(States::START);
+        stagesPlayed++;
+        LOG_INFO("Stage " << stageManager.getCurrentStage() << " started");
+    }
+}
+
+void Game::updateLossState(float deltaTime) {
+    // Initialize loss scene on first entry
+    if (!lossSceneInitialized) {
+        // Decrement lives ONCE when entering LOSS state
+        player.setLives(player.getLives() - 1);
+
+        // Play appropriate music based on lives remaining AFTER decrementing
+        if (player.getLives() > 0) {
+            lossMusic.play();
+            LOG_INFO("Player died! Lives remaining: " << player.getLives());
+        }
+        else {
+            noLivesMusic.play();
+            LOG_INFO("Player died! No lives remaining. Game Over!");
+            // The restart goes back to the first stage; prepare it during the delay
+            stageManager.prefetch(0);
+        }
+
+        lossSceneInitialized = true;
+        lossDelayTimer = 0.0f;
+    }
+
+    lossDelayTimer += deltaTime;
+
+    // Continue updating player to show death animation
+    player.Update(deltaTime, player.getPlayerPosition());
+
+    if (lossDelayTimer >= LOSS_DELAY) {
+        if (player.getLives() <= 0) {
+            // Game over - restart from stage 0
+            noLivesMusic.play();
+            stageManager.setCurrentStage(0);
+            loadStage(stageManager.getCurrentStage());
+
+            // Reset lives for new game
+            player.setLives(3);
+            LOG_INFO("Game Over - Restarting from Stage 0 with 3 lives");
+        }
+        else {
+            // Still have lives - restart current stage
+            LOG_INFO("Restarting current stage with " << player.getLives() << " lives remaining");
+        }
+
+        // Stop music and transition to start state
+        lossMusic.stop();
+        noLivesMusic.stop();
+
+        // Reset the loss scene flag for next time
+        lossSceneInitialized = false;
+
+        gameState.setGameState(States::START);
+        stagesPlayed++;
+    }
+}
+
+void Game::loadStage(int level) {
+    // Pick up level files edited since they were cached; a changed stage drops its stale prefetch
+    stageManager.reloadChanged();
+    // Normally prefetched while the previous stage was played, so this is just a swap
+    std::unique_ptr<Map::Stage> stage = stageManager.takeStage(level);
+    if (stage) {
+        map.swapStage(*stage);
+        LOG_INFO("Loaded stage " << level << ": " << stageManager.getMapFile(level));
+    }
+    else {
+        map.setCurrentLevel(level);
+        LOG_ERROR("Failed to load stage " << level);
+    }
+
+    // Every stage load gets its own stream so a run replays identically from its seed
+    enemyManager.SetSeed(Random::Combine(seed, stagesPlayed));
+    // Entities come from fixed pools, so once warmed up a respawn should not touch the heap
+    uint64_t allocationsBefore = AllocationCounter::ThisThread();
+    enemyManager.ClearAllEnemies();
+    enemyManager.ClearAllRocks();
+    enemyManager.SpawnEnemiesFromMap();
+    enemyManager.SpawnRocksFromMap();
+    lastRespawnAllocations = AllocationCounter::ThisThread() - allocationsBefore;
+    LOG_DEBUG("Stage " << level << " respawn made " << lastRespawnAllocations << " heap allocations");
+    // Drop anything the previous stage used that the new one did not pick back up
+    AssetCache::ReleaseUnused();
+
+    // Update spawn position for new map
+    const auto& spawns = map.getEntitySpawns();
+    for (const auto& spawn : spawns) {
+        if (spawn.first == '*') {
+            startPos = spawn.second;
+            break;
+        }
+    }
+    stageManager.prefetch(stageManager.getNextStage());
+}
+
+void Game::calculateStartSteps() {
+    float horizontalDistance = std::abs(startPos.x - initialPos.x);
+    horizontalSteps = static_cast<int>(horizontalDistance / TILE_SIZE);
+    float verticalDistance = startPos.y - 16;
+    verticalSteps = static_cast<int>(verticalDistance / TILE_SIZE);
+    TOTAL_START_STEPS = horizontalSteps + verticalSteps;
+}
+
+sf::Vector2f Game::snapToTileCenter(sf::Vector2f position) {
+    position.x = std::floor(position.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
+    position.y = std::floor(position.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
+    return position;
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Map.h"
+#include "Player.h"
+#include "EnemyManager.h"
+#include "GameState.h"
+#include "StageManager.h"
+#include "SFX.h"
+#include "Input.h"
+
+// Owns the simulation (map, player, enemies, stage flow) and the START/GAME/WIN/LOSS
+// state machine. Has no window of its own, so it can be driven by the windowed loop
+// in main or ticked headless.
+class Game {
+public:
+    static constexpr float FIXED_TIMESTEP = 1.0f / 120.0f;   // Simulation tick length
+    static const int MAX_STEPS_PER_ADVANCE = 64;            // Catch-up cap after a long frame
+
+private:
+    static const int TILE_SIZE = 16;
+    const float START_DELAY = 8.0f;
+    const float WIN_DELAY = 3.0f;
+    const float START_PAUSE_DELAY = 1.0f;
+    const float LOSS_DELAY = 6.0f;
+
+    StageManager stageManager;
+    GameState gameState;
+    Map map;
+    Player player;
+    EnemyManager enemyManager;
+
+    SFX victory;
+    SFX lossMusic;
+    SFX noLivesMusic;
+    SFX startMusic;
+
+    float winDelayTimer = 0.0f;
+    float startDelayTimer = 0.0f;
+    float startPauseTimer = 0.0f;
+    float lossDelayTimer = 0.0f;
+    int startSceneStep = 0;
+    int TOTAL_START_STEPS = 0;
+    bool startMovementComplete = false;
+    bool startSceneInitialized = false;
+    bool startPauseComplete = false;
+    bool movingHorizontally = true;
+    bool lossSceneInitialized = false;
+    int horizontalSteps = 0;
+    int verticalSteps = 0;
+    int stagesPlayed = 0;
+    uint64_t seed;
+    uint64_t lastRespawnAllocations = 0;   // Heap allocations made by the most recent entity respawn
+
+    // Fixed-step accumulator
+    float accumulator = 0.0f;
+    float timeScale = 1.0f;
+    bool interpolate = true;
+
+    // Input capture / playback, one InputState per tick
+    InputRecorder recorder;
+    InputReplay replay;
+    bool replaying = false;
+
+    // Player walks in from off-screen to startPos during START
+    sf::Vector2f initialPos = sf::Vector2f(-16, 16);
+    sf::Vector2f startPos;
+
+    void updateStartState(float deltaTime);
+    void updateGameState(float deltaTime);
+    void updateWinState(float deltaTime);
+    void updateLossState(float deltaTime);
+
+    InputState pollInput();
+    void loadStage(int level);
+    void calculateStartSteps();
+    static sf::Vector2f snapToTileCenter(sf::Vector2f position);
+
+public:
+    explicit Game(uint64_t seed);
+
+    bool Initialise();
+    int Advance(float frameTime);
+    void Update(float deltaTime);
+    void Draw(sf::RenderWindow& window);
+
+    // Both must be called before Initialise(); a replay also restores the recorded seed
+    bool StartRecording(const std::string& filename) { return recorder.Open(filename, seed); }
+    bool StartReplay(const std::string& filename);
+    bool IsReplaying() const { return replaying; }
+    bool IsReplayFinished() const { return replaying && replay.IsFinished(); }
+
+    void SetTimeScale(float scale) { timeScale = scale; }
+    void SetInterpolation(bool enable) { interpolate = enable; }
+
+    States getState() const { return gameState.getGameState(); }
+    Player& getPlayer() { return player; }
+    int getStagesPlayed() const { return stagesPlayed; }
+    uint64_t getSeed() const { return seed; }
+    uint64_t getLastRespawnAllocations() const { return lastRespawnAllocations; }
+};
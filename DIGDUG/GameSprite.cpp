@@ -0,0 +1,21 @@
+#include "GameSprite.h"
+
+float GameSprite::interpolationAlpha = 1.0f;
+
+void GameSprite::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+	if (texture == nullptr) {
+		return;
+	}
+	sf::Sprite sprite(*texture, textureRect);
+	sprite.setColor(color);
+	if (interpolationAlpha < 1.0f) {
+		sf::Transformable blended = *this;
+		blended.setPosition(getDrawPosition());
+		states.transform *= blended.getTransform();
+	}
+	else {
+		states.transform *= getTransform();
+	}
+	target.draw(sprite, states);
+}
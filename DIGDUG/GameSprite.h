@@ -0,0 +1,36 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+
+// Stand-in for sf::Sprite that does not require a texture to exist.
+// Gameplay code keeps its transform and texture rect here; drawing is a no-op
+// until a texture is set, which lets entities run headless.
+class GameSprite : public sf::Drawable, public sf::Transformable
+{
+public:
+	void setTexture(const sf::Texture& newTexture) { texture = &newTexture; }
+	const sf::Texture* getTexture() const { return texture; }
+
+	void setTextureRect(const sf::IntRect& rect) { textureRect = rect; }
+	const sf::IntRect& getTextureRect() const { return textureRect; }
+
+	void setColor(const sf::Color& newColor) { color = newColor; }
+	const sf::Color& getColor() const { return color; }
+
+	// Render interpolation: entities store their position at the start of each
+	// simulation step, draw() blends towards the current one by the global alpha
+	void storePreviousPosition() { previousPosition = getPosition(); }
+	static void SetInterpolationAlpha(float alpha) { interpolationAlpha = alpha; }
+	static float GetInterpolationAlpha() { return interpolationAlpha; }
+	// Where draw() puts the sprite this frame
+	sf::Vector2f getDrawPosition() const { return previousPosition + (getPosition() - previousPosition) * interpolationAlpha; }
+
+private:
+	void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+	const sf::Texture* texture = nullptr;
+	sf::IntRect textureRect;
+	sf::Color color = sf::Color::White;
+	sf::Vector2f previousPosition;
+
+	static float interpolationAlpha;
+};
@@ -0,0 +1,125 @@
+#include "Input.h"
+#include "Log.h"
+#include <SFML/Window/Keyboard.hpp>
+
+namespace {
+    const char MAGIC[4] = { 'D', 'D', 'I', 'N' };
+    const uint32_t VERSION = 1;
+    const uint32_t MAX_RUN = 0xFFFF;
+
+    template <typename T>
+    void writeLE(std::ofstream& out, T value) {
+        for (size_t i = 0; i < sizeof(T); i++) {
+            out.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    template <typename T>
+    bool readLE(std::ifstream& in, T& value) {
+        value = 0;
+        for (size_t i = 0; i < sizeof(T); i++) {
+            int byte = in.get();
+            if (byte == EOF) return false;
+            value |= static_cast<T>(static_cast<uint8_t>(byte)) << (8 * i);
+        }
+        return true;
+    }
+}
+
+InputState InputState::FromKeyboard() {
+    InputState state;
+    state.set(LEFT, sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A));
+    state.set(RIGHT, sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D));
+    state.set(UP, sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W));
+    state.set(DOWN, sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S));
+    state.set(FIRE, sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space));
+    return state;
+}
+
+InputRecorder::~InputRecorder() {
+    Close();
+}
+
+bool InputRecorder::Open(const std::string& filename, uint64_t seed) {
+    Close();
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open input recording: " << filename);
+        return false;
+    }
+    file.write(MAGIC, sizeof(MAGIC));
+    writeLE(file, VERSION);
+    writeLE(file, seed);
+    runLength = 0;
+    return true;
+}
+
+void InputRecorder::Record(const InputState& state) {
+    if (!file.is_open()) return;
+
+    if (runLength > 0 && (state != runState || runLength == MAX_RUN)) {
+        flushRun();
+    }
+    runState = state;
+    runLength++;
+}
+
+void InputRecorder::flushRun() {
+    writeLE(file, runState.buttons);
+    writeLE(file, static_cast<uint16_t>(runLength));
+    runLength = 0;
+}
+
+void InputRecorder::Close() {
+    if (!file.is_open()) return;
+    if (runLength > 0) {
+        flushRun();
+    }
+    file.close();
+}
+
+bool InputReplay::Open(const std::string& filename) {
+    file.open(filename, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open input replay: " << filename);
+        return false;
+    }
+
+    char magic[4] = {};
+    uint32_t version = 0;
+    file.read(magic, sizeof(magic));
+    if (!file || std::char_traits<char>::compare(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readLE(file, version) || version != VERSION || !readLE(file, seed)) {
+        LOG_ERROR("Not a valid input replay: " << filename);
+        file.close();
+        return false;
+    }
+
+    runRemaining = 0;
+    finished = false;
+    return true;
+}
+
+bool InputReplay::readRun() {
+    uint16_t length = 0;
+    if (!readLE(file, runState.buttons) || !readLE(file, length)) {
+        return false;
+    }
+    runRemaining = length;
+    return true;
+}
+
+bool InputReplay::Next(InputState& state) {
+    while (!finished && runRemaining == 0) {
+        if (!readRun()) {
+            finished = true;
+        }
+    }
+    if (finished) {
+        state = InputState();
+        return false;
+    }
+    state = runState;
+    runRemaining--;
+    return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+// Player input for one simulation tick, packed into a single byte.
+struct InputState {
+    enum Button : uint8_t {
+        LEFT = 1 << 0,
+        RIGHT = 1 << 1,
+        UP = 1 << 2,
+        DOWN = 1 << 3,
+        FIRE = 1 << 4
+    };
+
+    uint8_t buttons = 0;
+
+    bool isDown(Button button) const { return (buttons & button) != 0; }
+    void set(Button button, bool down) { buttons = down ? (buttons | button) : (buttons & ~button); }
+    bool operator==(const InputState& other) const { return buttons == other.buttons; }
+
+    // Samples A/D/W/S/Space; never call in headless mode
+    static InputState FromKeyboard();
+};
+
+// Writes per-tick input to a compact binary stream:
+//   header: "DDIN" magic, uint32 version, uint64 seed
+//   body:   runs of (uint8 buttons, uint16 tick count), little endian
+// Consecutive identical ticks share one run, so idle stretches cost 3 bytes.
+class InputRecorder {
+private:
+    std::ofstream file;
+    InputState runState;
+    uint32_t runLength = 0;
+
+    void flushRun();
+
+public:
+    ~InputRecorder();
+
+    bool Open(const std::string& filename, uint64_t seed);
+    void Record(const InputState& state);
+    void Close();
+    bool IsOpen() const { return file.is_open(); }
+};
+
+// Plays back a stream written by InputRecorder, one InputState per tick.
+class InputReplay {
+private:
+    std::ifstream file;
+    uint64_t seed = 0;
+    InputState runState;
+    uint32_t runRemaining = 0;
+    bool finished = true;
+
+    bool readRun();
+
+public:
+    bool Open(const std::string& filename);
+    // Returns false (and an empty state) once the recording is exhausted
+    bool Next(InputState& state);
+
+    uint64_t GetSeed() const { return seed; }
+    bool IsFinished() const { return finished; }
+};
@@ -0,0 +1,186 @@
+#include "LevelData.h"
+#include "Log.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <string_view>
+
+namespace {
+    // Character -> tile type for .rmap files. Every byte has an entry, so unknown
+    // characters fall through to Empty without a lookup miss.
+    constexpr std::array<TileType, 256> makeCharToTileType() {
+        std::array<TileType, 256> table{};
+        table.fill(TileType::Empty);
+        table['1'] = TileType::Surface;  // Surface
+        table['2'] = TileType::Dirt1;    // Dirt type 1
+        table['3'] = TileType::Dirt2;    // Dirt type 2
+        table['4'] = TileType::Dirt3;    // Dirt type 3
+        table['5'] = TileType::Dirt4;    // Dirt type 4
+        // '0', 'P' (enemy spawn), '*' (player spawn) and 'R' (rock) are open space
+        return table;
+    }
+    constexpr std::array<TileType, 256> CHAR_TO_TILE_TYPE = makeCharToTileType();
+
+    TileType charToTileType(char c) {
+        return CHAR_TO_TILE_TYPE[static_cast<unsigned char>(c)];
+    }
+
+    uint32_t alignSection(size_t offset) {
+        return static_cast<uint32_t>((offset + 7) & ~static_cast<size_t>(7));
+    }
+}
+
+bool ParsedLevel::readText(const std::string& filename, std::string& text) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool ParsedLevel::loadFromFile(const std::string& filename) {
+    // One read for the whole file, then split in place
+    std::string text;
+    if (!readText(filename, text)) {
+        LOG_ERROR("Failed to open map file: " << filename);
+        return false;
+    }
+    return parse(text, filename);
+}
+
+bool ParsedLevel::parse(std::string_view text, const std::string& name) {
+    sourceHash = Bmap::hashSource(text);
+
+    std::vector<std::string_view> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string_view line(text.data() + start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        lines.push_back(line);
+        start = end + 1;
+    }
+
+    size_t longest = 0;
+    for (std::string_view line : lines) {
+        longest = std::max(longest, line.size());
+    }
+    const size_t maxDimension = std::numeric_limits<uint16_t>::max();
+    if (longest > maxDimension || lines.size() > maxDimension) {
+        LOG_ERROR("Map file " << name << " is too large (" << longest << "x" << lines.size() << ")");
+        return false;
+    }
+    width = static_cast<uint16_t>(longest);
+    height = static_cast<uint16_t>(lines.size());
+
+    // Short lines are padded with open space
+    tiles.assign(static_cast<size_t>(width) * height, TileType::Empty);
+    spawns.clear();
+    rocks.clear();
+    for (uint16_t row = 0; row < height; row++) {
+        std::string_view line = lines[row];
+        for (uint16_t col = 0; col < line.size(); col++) {
+            char c = line[col];
+            tiles[static_cast<size_t>(row) * width + col] = charToTileType(c);
+            if (c == 'P' || c == '*') {
+                spawns.push_back({ col, row, c, {} });
+            }
+            else if (c == 'R') {
+                // The rock sits on the terrain to its right; at the edge it uses the surface
+                TileType source = (col + 1u < line.size()) ? charToTileType(line[col + 1]) : TileType::Surface;
+                rocks.push_back({ col, row, source, {} });
+            }
+        }
+    }
+    return true;
+}
+
+void ParsedLevel::assign(const LevelData& level, uint64_t levelSourceHash) {
+    sourceHash = levelSourceHash;
+    width = level.width;
+    height = level.height;
+    tiles.assign(level.tiles.begin(), level.tiles.end());
+    spawns.assign(level.spawns.begin(), level.spawns.end());
+    rocks.assign(level.rocks.begin(), level.rocks.end());
+}
+
+LevelData ParsedLevel::view() const {
+    LevelData level;
+    level.width = width;
+    level.height = height;
+    level.tiles = tiles;
+    level.spawns = spawns;
+    level.rocks = rocks;
+    return level;
+}
+
+uint64_t Bmap::hashSource(std::string_view text) {
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : text) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t Bmap::hashSourceFile(const std::string& filename) {
+    std::string text;
+    if (!ParsedLevel::readText(filename, text)) {
+        return 0;
+    }
+    return hashSource(text);
+}
+
+bool Bmap::readHeader(const std::string& filename, Header& header) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        return false;
+    }
+    return std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0 && header.version == VERSION;
+}
+
+bool Bmap::write(const LevelData& level, uint64_t sourceHash, const std::string& filename) {
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(Header);
+    header.width = level.width;
+    header.height = level.height;
+    header.spawnCount = static_cast<uint32_t>(level.spawns.size());
+    header.rockCount = static_cast<uint32_t>(level.rocks.size());
+    header.sourceHash = sourceHash;
+    header.tilesOffset = alignSection(sizeof(Header));
+    header.spawnsOffset = alignSection(header.tilesOffset + level.tiles.size());
+    header.rocksOffset = alignSection(header.spawnsOffset + level.spawns.size_bytes());
+    size_t fileSize = header.rocksOffset + level.rocks.size_bytes();
+
+    std::vector<char> bytes(fileSize, 0);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::memcpy(bytes.data() + header.tilesOffset, level.tiles.data(), level.tiles.size());
+    if (!level.spawns.empty()) {
+        std::memcpy(bytes.data() + header.spawnsOffset, level.spawns.data(), level.spawns.size_bytes());
+    }
+    if (!level.rocks.empty()) {
+        std::memcpy(bytes.data() + header.rocksOffset, level.rocks.data(), level.rocks.size_bytes());
+    }
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to create compiled map file: " << filename);
+        return false;
+    }
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        LOG_ERROR("Failed to write compiled map file: " << filename);
+        return false;
+    }
+    return true;
+}
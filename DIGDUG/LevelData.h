@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "TileType.h"
+
+// Spawn and rock records as stored in compiled .bmap levels. Fixed-size, naturally
+// aligned and pointer-free, so a mapped file can be read in place.
+struct LevelSpawn {
+    uint16_t col;
+    uint16_t row;
+    char type;              // 'P' = Pooka, '*' = player start
+    uint8_t reserved[3];
+};
+static_assert(sizeof(LevelSpawn) == 8);
+
+struct LevelRock {
+    uint16_t col;
+    uint16_t row;
+    TileType textureSource; // Terrain drawn behind the rock; resolved to a texture by the map palette
+    uint8_t reserved[3];
+};
+static_assert(sizeof(LevelRock) == 8);
+
+// Read-only view of a level: row-major tile grid plus spawn and rock tables.
+// Points into whatever owns the data (a ParsedLevel or a MappedLevel).
+struct LevelData {
+    uint16_t width = 0;
+    uint16_t height = 0;
+    std::span<const TileType> tiles;
+    std::span<const LevelSpawn> spawns;
+    std::span<const LevelRock> rocks;
+
+    TileType tileAt(int col, int row) const { return tiles[static_cast<size_t>(row) * width + col]; }
+};
+
+// A level parsed from .rmap text. Used by the level compiler and as the fallback
+// when no compiled level is available.
+class ParsedLevel {
+public:
+    bool loadFromFile(const std::string& filename);
+    // Parse .rmap text already in memory; name is only used in error messages
+    bool parse(std::string_view text, const std::string& name);
+    // Take an owned copy of any level, e.g. one that was mapped from a .bmap
+    void assign(const LevelData& level, uint64_t levelSourceHash);
+    LevelData view() const;
+    // Whole file as text, one read
+    static bool readText(const std::string& filename, std::string& text);
+    // Bmap::hashSource of the text this level was parsed from
+    uint64_t getSourceHash() const { return sourceHash; }
+
+private:
+    uint64_t sourceHash = 0;
+    uint16_t width = 0;
+    uint16_t height = 0;
+    std::vector<TileType> tiles;
+    std::vector<LevelSpawn> spawns;
+    std::vector<LevelRock> rocks;
+};
+
+// Compiled level layout. All values little-endian, sections 8-byte aligned:
+//   Header | tiles (width * height bytes) | spawns (LevelSpawn[]) | rocks (LevelRock[])
+namespace Bmap {
+    constexpr char MAGIC[4] = { 'B', 'M', 'A', 'P' };
+    constexpr uint16_t VERSION = 1;
+    constexpr const char* EXTENSION = ".bmap";
+
+    struct Header {
+        char magic[4];
+        uint16_t version;
+        uint16_t headerSize;
+        uint16_t width;
+        uint16_t height;
+        uint32_t spawnCount;
+        uint32_t rockCount;
+        uint32_t tilesOffset;   // Byte offsets from the start of the file
+        uint32_t spawnsOffset;
+        uint32_t rocksOffset;
+        uint32_t reserved;
+        uint64_t sourceHash;    // Of the .rmap text, so staleness can be checked without timestamps
+    };
+    static_assert(sizeof(Header) == 48);
+
+    bool write(const LevelData& level, uint64_t sourceHash, const std::string& filename);
+    bool readHeader(const std::string& filename, Header& header);
+    // FNV-1a over the raw text
+    uint64_t hashSource(std::string_view text);
+    // Hash of a source file's contents, or 0 if it can't be read
+    uint64_t hashSourceFile(const std::string& filename);
+}
@@ -0,0 +1,119 @@
+#include "Log.h"
+#include <array>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <thread>
+
+std::atomic<LogLevel> Log::minimumLevel{ static_cast<LogLevel>(LOG_MIN_LEVEL) };
+
+namespace {
+    class LogWriter {
+    private:
+        struct Entry {
+            LogLevel level = LogLevel::Info;
+            std::string message;
+        };
+        static const size_t CAPACITY = 4096;
+
+        std::array<Entry, CAPACITY> ring;
+        size_t head = 0;    // Next slot to write out
+        size_t count = 0;   // Queued entries
+        size_t dropped = 0;
+        size_t written = 0; // Total entries handed to the console
+        size_t queued = 0;  // Total entries accepted
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable drained;
+        bool stopping = false;
+        std::thread worker;
+
+        void run() {
+            std::vector<Entry> batch;
+            batch.reserve(CAPACITY);
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                wake.wait(lock, [this] { return count > 0 || dropped > 0 || stopping; });
+                if (count == 0 && dropped == 0 && stopping) break;
+
+                // Take the whole backlog in one go and write it without holding the lock
+                while (count > 0) {
+                    batch.push_back(std::move(ring[head]));
+                    head = (head + 1) % CAPACITY;
+                    count--;
+                }
+                size_t droppedNow = dropped;
+                dropped = 0;
+                lock.unlock();
+
+                bool wroteOut = false;
+                bool wroteErr = false;
+                for (Entry& entry : batch) {
+                    std::ostream& stream = (entry.level >= LogLevel::Warning) ? std::cerr : std::cout;
+                    stream << entry.message << '\n';
+                    (entry.level >= LogLevel::Warning ? wroteErr : wroteOut) = true;
+                }
+                if (droppedNow > 0) {
+                    std::cerr << "[log] dropped " << droppedNow << " messages (ring buffer full)" << '\n';
+                    wroteErr = true;
+                }
+                if (wroteOut) std::cout.flush();
+                if (wroteErr) std::cerr.flush();
+
+                lock.lock();
+                written += batch.size();
+                batch.clear();
+                drained.notify_all();
+            }
+        }
+
+    public:
+        LogWriter() : worker(&LogWriter::run, this) {}
+
+        ~LogWriter() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            wake.notify_one();
+            worker.join();
+        }
+
+        void push(LogLevel level, std::string message) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (count == CAPACITY) {
+                    dropped++;
+                    return;
+                }
+                Entry& entry = ring[(head + count) % CAPACITY];
+                entry.level = level;
+                entry.message = std::move(message);
+                count++;
+                queued++;
+            }
+            wake.notify_one();
+        }
+
+        void flush() {
+            std::unique_lock<std::mutex> lock(mutex);
+            size_t target = queued;
+            drained.wait(lock, [this, target] { return written >= target; });
+        }
+    };
+
+    LogWriter& writer() {
+        static LogWriter instance;
+        return instance;
+    }
+}
+
+void Log::Write(LogLevel level, std::string message) {
+    writer().push(level, std::move(message));
+}
+
+void Log::Flush() {
+    writer().flush();
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+
+enum class LogLevel : uint8_t {
+    Debug = 0,
+    Info = 1,
+    Warning = 2,
+    Error = 3
+};
+
+// Messages below LOG_MIN_LEVEL are compiled out entirely. Release builds strip
+// Debug by default; override with e.g. /DLOG_MIN_LEVEL=0.
+#ifndef LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define LOG_MIN_LEVEL 1
+#else
+#define LOG_MIN_LEVEL 0
+#endif
+#endif
+
+// Levelled logger. Callers only format a message when its level is enabled, then
+// hand it to a fixed-size ring buffer; a background thread writes the buffer out
+// in batches, so game code never waits on console I/O. When the ring is full new
+// messages are dropped and counted rather than blocking.
+class Log
+{
+public:
+    // Whether a level survives LOG_MIN_LEVEL; compared as LogLevel so a minimum of 0
+    // does not trip -Wtype-limits
+    static constexpr bool IsCompiledIn(LogLevel level) { return level >= static_cast<LogLevel>(LOG_MIN_LEVEL); }
+    // Read from any thread that logs, e.g. the stage prefetch worker
+    static bool IsEnabled(LogLevel level) { return level >= minimumLevel.load(std::memory_order_relaxed); }
+    static void SetLevel(LogLevel level) { minimumLevel.store(level, std::memory_order_relaxed); }
+
+    static void Write(LogLevel level, std::string message);
+    // Blocks until everything queued so far has been written
+    static void Flush();
+
+private:
+    static std::atomic<LogLevel> minimumLevel;
+};
+
+#define LOG_AT(level, expr) \
+    do { \
+        if constexpr (Log::IsCompiledIn(level)) { \
+            if (Log::IsEnabled(level)) { \
+                std::ostringstream logStream_; \
+                logStream_ << expr; \
+                Log::Write(level, logStream_.str()); \
+            } \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(expr) LOG_AT(LogLevel::Debug, expr)
+#define LOG_INFO(expr) LOG_AT(LogLevel::Info, expr)
+#define LOG_WARNING(expr) LOG_AT(LogLevel::Warning, expr)
+#define LOG_ERROR(expr) LOG_AT(LogLevel::Error, expr)
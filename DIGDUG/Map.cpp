@@ -1,210 +1,505 @@
 
 #include "Map.h"
+#include "Log.h"
 #include "StageManager.h"
-#include <fstream>
-#include <iostream>
+#include "TextureAtlas.h"
+#include "Profiler.h"
+#include "MappedLevel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 
-Map::Map() : tileSprite(tileTexture), currentLevel(0) {
-    tileData.resize(TILES_Y, std::vector<int>(TILES_X, 0));
-    setupTileMappings();
-    setupTextureMapping();
+namespace {
+    // Tilesheet index for each tile type, one palette per level.
+    // Levels past the end of the table reuse the last palette.
+    constexpr std::array<Map::TexturePalette, 3> LEVEL_PALETTES = {{
+        { 0, 1, 2, 3, 4, 5 },
+        { 0, 1, 6, 7, 8, 9 },
+        { 0, 1, 10, 11, 12, 13 },
+    }};
+}
 
-    if (!tileTexture.loadFromFile("Assets/Map/tilesheet.png")) {
-        std::cerr << "Failed to load tilesheet texture!" << std::endl;
-    }
-    tileSprite.setTexture(tileTexture);
+Map::Map() : currentLevel(0) {
+    tileData.assign(tilesX * tilesY, TileType::Empty);
+    setupTextureMapping();
+    tileSheet = TextureAtlas::GetRegion("Assets/Map/tilesheet.png");
+    resetChunks();
+    // Until something draws with a view, cover the classic screen, which fits in the first chunk
+    visibleChunks = sf::IntRect({ 0, 0 }, { 1, 1 });
 }
 
-void Map::setupTileMappings() {
-    // Keep tile types consistent - always map to 0-5
-    charToTileType.clear();
-    charToTileType['0'] = 0;  // Empty/tunnel
-    charToTileType['1'] = 1;  // Surface
-    charToTileType['2'] = 2;  // Dirt type 1
-    charToTileType['3'] = 3;  // Dirt type 2
-    charToTileType['4'] = 4;  // Dirt type 3
-    charToTileType['5'] = 5;  // Dirt type 4
-    charToTileType['P'] = 0;  // Enemy spawn
-    charToTileType['*'] = 0;  // Player spawn
-    charToTileType['R'] = 0;  // Rock will be placed on an empty tile initially
+const Map::TexturePalette& Map::paletteFor(int level) {
+    return LEVEL_PALETTES[std::clamp(level, 0, static_cast<int>(LEVEL_PALETTES.size()) - 1)];
 }
 
 void Map::setupTextureMapping() {
     // Map tile types to texture indices based on current level
-    tileTypeToTexture.clear();
-
-    if (currentLevel == 0) {
-        tileTypeToTexture[0] = 0;  // Empty
-        tileTypeToTexture[1] = 1;  // Surface
-        tileTypeToTexture[2] = 2;  // Dirt variations
-        tileTypeToTexture[3] = 3;
-        tileTypeToTexture[4] = 4;
-        tileTypeToTexture[5] = 5;
-    }
-    else if (currentLevel <= 1) {
-        tileTypeToTexture[0] = 0;  // Empty
-        tileTypeToTexture[1] = 1;  // Surface
-        tileTypeToTexture[2] = 6;  // Different dirt textures
-        tileTypeToTexture[3] = 7;
-        tileTypeToTexture[4] = 8;
-        tileTypeToTexture[5] = 9;
-    }
-    else if (currentLevel <= 2) {
-        tileTypeToTexture[0] = 0;  // Empty
-        tileTypeToTexture[1] = 1;  // Surface
-        tileTypeToTexture[2] = 10; // Different dirt textures
-        tileTypeToTexture[3] = 11;
-        tileTypeToTexture[4] = 12;
-        tileTypeToTexture[5] = 13;
-    }
+    tileTypeToTexture = paletteFor(currentLevel);
 }
 
 void Map::setCurrentLevel(int level) {
     currentLevel = level;
     setupTextureMapping(); // Only update texture mapping, not tile types
     buildTiles(); // Rebuild sprites with new textures
-    std::cout << "Map level set to: " << currentLevel << std::endl;
+    LOG_INFO("Map level set to: " << currentLevel);
 }
 
 bool Map::loadFromFile(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Failed to open map file: " << filename << std::endl;
+    Stage stage;
+    if (!prepareStage(filename, currentLevel, stage)) {
         return false;
     }
+    swapStage(stage);
+    LOG_INFO("Map loaded successfully from " << filename);
+    LOG_INFO("Found " << entitySpawns.size() << " entity spawns");
+    LOG_INFO("Found " << rockSpawns.size() << " rock spawns");
+    return true;
+}
 
-    std::string line;
-    int row = 0;
-    entitySpawns.clear();
-    rockSpawns.clear(); // Clear previous rock spawns
+void Map::loadLevel(const LevelData& level) {
+    Stage stage;
+    prepareStage(level, currentLevel, stage);
+    swapStage(stage);
+}
 
-    while (std::getline(file, line) && row < TILES_Y) {
-        for (int col = 0; col < TILES_X && col < static_cast<int>(line.length()); col++) {
-            char c = line[col];
-            if (charToTileType.find(c) != charToTileType.end()) {
-                tileData[row][col] = charToTileType[c];
-                if (c == 'P' || c == '*') {
-                    sf::Vector2f spawnPos(col * TILE_SIZE + TILE_SIZE / 2.0f, row * TILE_SIZE + TILE_SIZE / 2.0f);
-                    entitySpawns.emplace_back(c, spawnPos);
-                }
-                else if (c == 'R') {
-                    // Handle Rock spawn: get texture from tile to the right
-                    sf::Vector2f spawnPos(col * TILE_SIZE + TILE_SIZE / 2.0f, row * TILE_SIZE + TILE_SIZE / 2.0f);
-                    RockSpawnInfo rockInfo;
-                    rockInfo.position = spawnPos;
-
-                    // Determine texture index from the tile to the right
-                    if (col + 1 < TILES_X) {
-                        char tileRightChar = line[col + 1];
-                        int tileRightType = 0;
-                        if (charToTileType.find(tileRightChar) != charToTileType.end()) {
-                            tileRightType = charToTileType[tileRightChar];
-                        }
-                        rockInfo.textureIndex = tileTypeToTexture[tileRightType];
-                    }
-                    else {
-                        // Default to a specific texture if no tile to the right or out of bounds
-                        rockInfo.textureIndex = tileTypeToTexture[1]; // Example: Use surface texture
-                    }
-                    rockSpawns.push_back(rockInfo);
-                    tileData[row][col] = 0; // The 'R' tile itself is considered empty space
-                }
-            }
-            else {
-                tileData[row][col] = 0;
-            }
+bool Map::prepareStage(const std::string& filename, int level, Stage& out) {
+    // Compiled levels are mapped and read in place; .rmap text is the fallback
+    if (filename.ends_with(Bmap::EXTENSION)) {
+        MappedLevel mapped;
+        if (!mapped.open(filename)) {
+            return false;
         }
-        for (int col = static_cast<int>(line.length()); col < TILES_X; col++) {
-            tileData[row][col] = 0;
+        prepareStage(mapped.data(), level, out);
+    }
+    else {
+        ParsedLevel parsed;
+        if (!parsed.loadFromFile(filename)) {
+            return false;
         }
-        row++;
+        prepareStage(parsed.view(), level, out);
     }
+    return true;
+}
 
-    for (int r = row; r < TILES_Y; r++) {
-        for (int c = 0; c < TILES_X; c++) {
-            tileData[r][c] = 0;
+void Map::prepareStage(const LevelData& data, int level, Stage& out) {
+    out.level = level;
+    out.palette = paletteFor(level);
+
+    // The grid takes the level's size; an empty level keeps the classic screen
+    if (data.width > MAX_TILES || data.height > MAX_TILES) {
+        LOG_WARNING("Level is " << data.width << "x" << data.height << " tiles; cropping to " << MAX_TILES << " per side");
+    }
+    out.tilesX = data.width > 0 ? std::min<int>(data.width, MAX_TILES) : DEFAULT_TILES_X;
+    out.tilesY = data.height > 0 ? std::min<int>(data.height, MAX_TILES) : DEFAULT_TILES_Y;
+    const int columns = std::min<int>(data.width, out.tilesX);
+    const int rows = std::min<int>(data.height, out.tilesY);
+    out.tileData.assign(static_cast<size_t>(out.tilesX) * out.tilesY, TileType::Empty);
+    for (int row = 0; row < rows; row++) {
+        const TileType* source = data.tiles.data() + static_cast<size_t>(row) * data.width;
+        std::copy(source, source + columns, out.tileData.begin() + static_cast<size_t>(row) * out.tilesX);
+    }
+
+    out.entitySpawns.clear();
+    for (const LevelSpawn& spawn : data.spawns) {
+        if (spawn.col < columns && spawn.row < rows) {
+            out.entitySpawns.emplace_back(spawn.type, tileCentre(spawn.col, spawn.row));
+        }
+    }
+    out.rockSpawns.clear();
+    for (const LevelRock& rock : data.rocks) {
+        if (rock.col < columns && rock.row < rows) {
+            out.rockSpawns.push_back({ tileCentre(rock.col, rock.row), out.palette[static_cast<uint8_t>(rock.textureSource)] });
         }
     }
 
-    file.close();
-    buildTiles();
-    std::cout << "Map loaded successfully from " << filename << std::endl;
-    std::cout << "Found " << entitySpawns.size() << " entity spawns" << std::endl;
-    std::cout << "Found " << rockSpawns.size() << " rock spawns" << std::endl;
-    return true;
+    buildTunnelIndex(out.tileData, out.tilesX, out.tilesY, out.tunnelParent, out.tunnelRank);
+}
+
+void Map::swapStage(Stage& stage) {
+    std::swap(currentLevel, stage.level);
+    std::swap(tileTypeToTexture, stage.palette);
+    std::swap(tilesX, stage.tilesX);
+    std::swap(tilesY, stage.tilesY);
+    std::swap(tileData, stage.tileData);
+    std::swap(entitySpawns, stage.entitySpawns);
+    std::swap(rockSpawns, stage.rockSpawns);
+    std::swap(tunnelParent, stage.tunnelParent);
+    std::swap(tunnelRank, stage.tunnelRank);
+    tunnelIndexStale = false;
+    revision++;
+    resetChunks();
+}
+
+void Map::resetChunks() {
+    // Geometry is rebuilt on demand, so a new stage only needs every chunk dirty
+    int columns = (tilesX + CHUNK_TILES - 1) / CHUNK_TILES;
+    int rows = (tilesY + CHUNK_TILES - 1) / CHUNK_TILES;
+    if (columns != chunksX || rows != chunksY) {
+        chunksX = columns;
+        chunksY = rows;
+        chunks.clear();
+        chunks.resize(static_cast<size_t>(chunksX) * chunksY);
+        builtChunks.clear();
+    }
+    for (Chunk& chunk : chunks) {
+        chunk.dirty = true;
+    }
 }
 
 void Map::buildTiles() {
-    tileSprites.clear();
-    tileSprites.reserve(TILES_X * TILES_Y);
+    PROFILE_SCOPE("Map::buildTiles");
+    // Full rebuild, used on palette change; edits patch single cells and scrolling builds only new chunks
+    for (Chunk& chunk : chunks) {
+        chunk.dirty = true;
+    }
+    int right = std::min(visibleChunks.position.x + visibleChunks.size.x, chunksX);
+    int bottom = std::min(visibleChunks.position.y + visibleChunks.size.y, chunksY);
+    for (int cy = visibleChunks.position.y; cy < bottom; cy++) {
+        for (int cx = visibleChunks.position.x; cx < right; cx++) {
+            rebuildChunk(cy * chunksX + cx);
+        }
+    }
+}
+
+void Map::setVisibleArea(const sf::FloatRect& area) {
+    const float chunkSize = static_cast<float>(CHUNK_TILES * TILE_SIZE);
+    int left = std::max(0, static_cast<int>(std::floor(area.position.x / chunkSize)));
+    int top = std::max(0, static_cast<int>(std::floor(area.position.y / chunkSize)));
+    int right = std::min(chunksX, static_cast<int>(std::ceil((area.position.x + area.size.x) / chunkSize)));
+    int bottom = std::min(chunksY, static_cast<int>(std::ceil((area.position.y + area.size.y) / chunkSize)));
+    visibleChunks = sf::IntRect({ left, top }, { std::max(0, right - left), std::max(0, bottom - top) });
+
+    for (int cy = top; cy < bottom; cy++) {
+        for (int cx = left; cx < right; cx++) {
+            if (chunks[cy * chunksX + cx].dirty) {
+                rebuildChunk(cy * chunksX + cx);
+            }
+        }
+    }
+    if (builtChunks.size() > MAX_BUILT_CHUNKS) {
+        freeChunksOutOfView();
+    }
+}
+
+void Map::rebuildChunk(int index) {
+    Chunk& chunk = chunks[index];
+    int firstCol = (index % chunksX) * CHUNK_TILES;
+    int firstRow = (index / chunksX) * CHUNK_TILES;
+    int lastCol = std::min(firstCol + CHUNK_TILES, tilesX);
+    int lastRow = std::min(firstRow + CHUNK_TILES, tilesY);
+
+    if (chunk.vertices.capacity() == 0 && !spareVertices.empty()) {
+        chunk.vertices = std::move(spareVertices.back());
+        spareVertices.pop_back();
+    }
+    chunk.vertices.resize(static_cast<size_t>(lastCol - firstCol) * (lastRow - firstRow) * VERTICES_PER_TILE);
+    sf::Vertex* quad = chunk.vertices.data();
+    for (int row = firstRow; row < lastRow; row++) {
+        for (int col = firstCol; col < lastCol; col++) {
+            writeTile(quad, col, row, tileData[tileIndex(col, row)], tileTypeToTexture, sf::Vector2f(tileSheet.offset));
+            quad += VERTICES_PER_TILE;
+        }
+    }
+    chunk.dirty = false;
+    chunk.uploaded = false;
+    chunk.patchedFirst = chunk.patchedLast = 0;
+    if (!chunk.built) {
+        chunk.built = true;
+        builtChunks.push_back(index);
+    }
+}
+
+void Map::freeChunksOutOfView() {
+    // Long scrolls over a big world would otherwise keep geometry for everything seen.
+    // The vertex storage is kept for the chunks that scroll in next.
+    std::erase_if(builtChunks, [this](int index) {
+        if (visibleChunks.contains({ index % chunksX, index / chunksX })) {
+            return false;
+        }
+        Chunk& chunk = chunks[index];
+        chunk.vertices.clear();
+        if (spareVertices.size() < MAX_BUILT_CHUNKS) {
+            spareVertices.push_back(std::move(chunk.vertices));
+        }
+        chunk.vertices = {};
+        chunk.buffer.reset();
+        chunk.dirty = true;
+        chunk.uploaded = false;
+        chunk.built = false;
+        return true;
+    });
+}
+
+void Map::updateTile(int col, int row) {
+    int firstCol = (col / CHUNK_TILES) * CHUNK_TILES;
+    int firstRow = (row / CHUNK_TILES) * CHUNK_TILES;
+    Chunk& chunk = chunks[(row / CHUNK_TILES) * chunksX + col / CHUNK_TILES];
+    if (chunk.dirty) {
+        return;   // Not built yet; the full build will pick the cell up
+    }
+    int columns = std::min(CHUNK_TILES, tilesX - firstCol);
+    size_t first = static_cast<size_t>((row - firstRow) * columns + (col - firstCol)) * VERTICES_PER_TILE;
+    writeTile(&chunk.vertices[first], col, row, tileData[tileIndex(col, row)], tileTypeToTexture, sf::Vector2f(tileSheet.offset));
 
-    for (int row = 0; row < TILES_Y; row++) {
-        for (int col = 0; col < TILES_X; col++) {
-            int tileType = tileData[row][col];
-            if (tileType == 0) continue;
+    size_t last = first + VERTICES_PER_TILE;
+    if (chunk.patchedFirst >= chunk.patchedLast) {
+        chunk.patchedFirst = first;
+        chunk.patchedLast = last;
+    }
+    else {
+        chunk.patchedFirst = std::min(chunk.patchedFirst, first);
+        chunk.patchedLast = std::max(chunk.patchedLast, last);
+    }
+}
 
-            // Use texture mapping to get the correct texture index
-            int textureIndex = tileTypeToTexture[tileType];
+void Map::updateTileAndNeighbours(int col, int row) {
+    // Neighbours are patched too so edge/transition tiles can depend on adjacent cells
+    static const int offsets[5][2] = { { 0, 0 }, { -1, 0 }, { 1, 0 }, { 0, -1 }, { 0, 1 } };
+    for (const auto& offset : offsets) {
+        int c = col + offset[0];
+        int r = row + offset[1];
+        if (inBounds(c, r)) {
+            updateTile(c, r);
+        }
+    }
+}
 
-            sf::Sprite sprite = tileSprite;
-            sprite.setTextureRect(sf::IntRect({ textureIndex * TILE_SIZE, 0 }, { TILE_SIZE, TILE_SIZE }));
-            sprite.setPosition(sf::Vector2f(col * TILE_SIZE, row * TILE_SIZE));
-            tileSprites.push_back(sprite);
+void Map::writeTile(sf::Vertex* quad, int col, int row, TileType tileType, const TexturePalette& palette, sf::Vector2f texOrigin) {
+    if (tileType == TileType::Empty) {
+        // Collapse the quad so empty cells rasterise nothing but keep their slot
+        for (int i = 0; i < VERTICES_PER_TILE; i++) {
+            quad[i].position = sf::Vector2f(static_cast<float>(col * TILE_SIZE), static_cast<float>(row * TILE_SIZE));
         }
+        return;
     }
+
+    // Use texture mapping to get the correct texture index
+    int textureIndex = palette[static_cast<uint8_t>(tileType)];
+    float left = static_cast<float>(col * TILE_SIZE);
+    float top = static_cast<float>(row * TILE_SIZE);
+    float right = left + TILE_SIZE;
+    float bottom = top + TILE_SIZE;
+    float texLeft = texOrigin.x + static_cast<float>(textureIndex * TILE_SIZE);
+    float texRight = texLeft + TILE_SIZE;
+    float texTop = texOrigin.y;
+    float texBottom = texTop + TILE_SIZE;
+
+    quad[0].position = sf::Vector2f(left, top);
+    quad[1].position = sf::Vector2f(right, top);
+    quad[2].position = sf::Vector2f(left, bottom);
+    quad[3].position = sf::Vector2f(left, bottom);
+    quad[4].position = sf::Vector2f(right, top);
+    quad[5].position = sf::Vector2f(right, bottom);
+
+    quad[0].texCoords = sf::Vector2f(texLeft, texTop);
+    quad[1].texCoords = sf::Vector2f(texRight, texTop);
+    quad[2].texCoords = sf::Vector2f(texLeft, texBottom);
+    quad[3].texCoords = sf::Vector2f(texLeft, texBottom);
+    quad[4].texCoords = sf::Vector2f(texRight, texTop);
+    quad[5].texCoords = sf::Vector2f(texRight, texBottom);
 }
 
 void Map::draw(sf::RenderWindow& window) {
-    for (const auto& sprite : tileSprites) {
-        window.draw(sprite);
+    PROFILE_SCOPE("Map::draw");
+    const sf::View& view = window.getView();
+    setVisibleArea(sf::FloatRect(view.getCenter() - view.getSize() / 2.0f, view.getSize()));
+    sf::RenderStates states;
+    states.texture = tileSheet.texture.get();
+    // Chunks live in GPU buffers where available. A build uploads the whole chunk,
+    // an edit only the range of the cells it patched.
+    const bool useBuffers = sf::VertexBuffer::isAvailable();
+    int right = visibleChunks.position.x + visibleChunks.size.x;
+    int bottom = visibleChunks.position.y + visibleChunks.size.y;
+    for (int cy = visibleChunks.position.y; cy < bottom; cy++) {
+        for (int cx = visibleChunks.position.x; cx < right; cx++) {
+            Chunk& chunk = chunks[cy * chunksX + cx];
+            if (chunk.vertices.empty()) {
+                continue;
+            }
+            if (useBuffers && !chunk.uploaded) {
+                if (!chunk.buffer) {
+                    chunk.buffer = std::make_unique<sf::VertexBuffer>(sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Dynamic);
+                }
+                chunk.uploaded = chunk.buffer->update(chunk.vertices.data(), chunk.vertices.size(), 0);
+            }
+            else if (chunk.uploaded && chunk.patchedFirst < chunk.patchedLast) {
+                size_t count = chunk.patchedLast - chunk.patchedFirst;
+                chunk.uploaded = chunk.buffer->update(chunk.vertices.data() + chunk.patchedFirst, count, static_cast<unsigned int>(chunk.patchedFirst));
+            }
+            chunk.patchedFirst = chunk.patchedLast = 0;
+            if (chunk.uploaded) {
+                window.draw(*chunk.buffer, 0, chunk.vertices.size(), states);
+            }
+            else {
+                window.draw(chunk.vertices.data(), chunk.vertices.size(), sf::PrimitiveType::Triangles, states);
+            }
+        }
     }
 }
 
-int Map::getTileAt(float x, float y) {
+TileType Map::getTileAt(float x, float y) const {
     int col = static_cast<int>(x) / TILE_SIZE;
     int row = static_cast<int>(y) / TILE_SIZE;
 
-    if (row >= 0 && row < TILES_Y && col >= 0 && col < TILES_X) {
-        return tileData[row][col];
+    if (inBounds(col, row)) {
+        return tileData[tileIndex(col, row)];
+    }
+    return TileType::OutOfBounds;
+}
+
+void Map::setTileAt(float x, float y, TileType tileType) {
+    int col = static_cast<int>(x) / TILE_SIZE;
+    int row = static_cast<int>(y) / TILE_SIZE;
+
+    if (inBounds(col, row)) {
+        TileType& tile = tileData[tileIndex(col, row)];
+        if (tile != tileType) {
+            revision++;
+            if (tileType == TileType::Empty) {
+                tile = tileType;
+                openTunnelCell(col, row);
+            }
+            else if (tile == TileType::Empty) {
+                tunnelIndexStale = true;
+            }
+            tile = tileType;
+            updateTileAndNeighbours(col, row);
+        }
+    }
+}
+
+void Map::rebuildTunnelIndex() const {
+    buildTunnelIndex(tileData, tilesX, tilesY, tunnelParent, tunnelRank);
+    tunnelIndexStale = false;
+}
+
+void Map::buildTunnelIndex(const std::vector<TileType>& tiles, int columns, int rows, std::vector<int32_t>& parent, std::vector<uint8_t>& rank) {
+    parent.resize(tiles.size());
+    rank.assign(tiles.size(), 0);
+    for (size_t i = 0; i < tiles.size(); i++) {
+        parent[i] = tiles[i] == TileType::Empty ? static_cast<int32_t>(i) : -1;
+    }
+    // Joining each cell with its right and lower neighbour covers every edge once
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < columns; col++) {
+            int32_t cell = row * columns + col;
+            if (parent[cell] < 0) {
+                continue;
+            }
+            if (col + 1 < columns && parent[cell + 1] >= 0) {
+                uniteTunnels(parent, rank, cell, cell + 1);
+            }
+            if (row + 1 < rows && parent[cell + columns] >= 0) {
+                uniteTunnels(parent, rank, cell, cell + columns);
+            }
+        }
+    }
+}
+
+int32_t Map::findTunnel(std::vector<int32_t>& parent, int32_t cell) {
+    // Path halving: every visited cell skips to its grandparent
+    while (parent[cell] != cell) {
+        parent[cell] = parent[parent[cell]];
+        cell = parent[cell];
+    }
+    return cell;
+}
+
+void Map::uniteTunnels(std::vector<int32_t>& parent, std::vector<uint8_t>& rank, int32_t a, int32_t b) {
+    a = findTunnel(parent, a);
+    b = findTunnel(parent, b);
+    if (a == b) {
+        return;
+    }
+    if (rank[a] < rank[b]) {
+        std::swap(a, b);
+    }
+    parent[b] = a;
+    if (rank[a] == rank[b]) {
+        rank[a]++;
+    }
+}
+
+void Map::openTunnelCell(int col, int row) {
+    if (tunnelIndexStale) {
+        return;   // The pending rebuild will pick this cell up
+    }
+    int32_t cell = tileIndex(col, row);
+    tunnelParent[cell] = cell;
+    tunnelRank[cell] = 0;
+    constexpr int offsets[4][2] = { { 0, -1 }, { 0, 1 }, { -1, 0 }, { 1, 0 } };
+    for (const auto& offset : offsets) {
+        int nx = col + offset[0];
+        int ny = row + offset[1];
+        if (inBounds(nx, ny) && tunnelParent[tileIndex(nx, ny)] >= 0) {
+            uniteTunnels(tunnelParent, tunnelRank, cell, tileIndex(nx, ny));
+        }
     }
-    return -1;
 }
 
-void Map::setTileAt(float x, float y, int tileType) {
+int Map::getTunnelId(float x, float y) const {
+    if (x < 0 || y < 0) {
+        return -1;
+    }
     int col = static_cast<int>(x) / TILE_SIZE;
     int row = static_cast<int>(y) / TILE_SIZE;
+    if (!inBounds(col, row)) {
+        return -1;
+    }
+    if (tunnelIndexStale) {
+        rebuildTunnelIndex();
+    }
+    int32_t cell = tileIndex(col, row);
+    return tunnelParent[cell] < 0 ? -1 : findTunnel(tunnelParent, cell);
+}
+
+bool Map::areConnected(sf::Vector2f a, sf::Vector2f b) const {
+    int32_t first = getTunnelId(a.x, a.y);
+    return first >= 0 && first == getTunnelId(b.x, b.y);
+}
 
-    if (row >= 0 && row < TILES_Y && col >= 0 && col < TILES_X) {
-        tileData[row][col] = tileType;
-        buildTiles();
+TileType Map::getTileAtGrid(int gridX, int gridY) const {
+    if (inBounds(gridX, gridY)) {
+        return tileData[tileIndex(gridX, gridY)];
     }
+    return TileType::OutOfBounds;
 }
 
-int Map::getTileAtGrid(int gridX, int gridY) {
-    if (gridY >= 0 && gridY < TILES_Y && gridX >= 0 && gridX < TILES_X) {
-        return tileData[gridY][gridX];
+bool Map::isSolid(float x, float y) const {
+    return isSolidTile(getTileAt(x, y));
+}
+
+std::span<const TileType> Map::getRow(int row) const {
+    if (row < 0 || row >= tilesY) {
+        return {};
     }
-    return -1;
+    return std::span<const TileType>(tileData.data() + tileIndex(0, row), tilesX);
 }
 
-bool Map::isSolid(float x, float y) {
-    int tileType = getTileAt(x, y);
-    return tileType > 0;
+int Map::getColumn(int col, std::span<TileType> out) const {
+    if (col < 0 || col >= tilesX) {
+        return 0;
+    }
+    int count = std::min(tilesY, static_cast<int>(out.size()));
+    for (int row = 0; row < count; row++) {
+        out[row] = tileData[tileIndex(col, row)];
+    }
+    return count;
 }
 
 sf::Vector2i Map::getMapSize() const {
-    return sf::Vector2i(MAP_WIDTH, MAP_HEIGHT);
+    return sf::Vector2i(tilesX * TILE_SIZE, tilesY * TILE_SIZE);
 }
 
 sf::Vector2i Map::getGridSize() const {
-    return sf::Vector2i(TILES_X, TILES_Y);
+    return sf::Vector2i(tilesX, tilesY);
 }
 
 void Map::printInfo() {
-    std::cout << "Map Info:" << std::endl;
-    std::cout << "  Pixel size: " << MAP_WIDTH << "x" << MAP_HEIGHT << std::endl;
-    std::cout << "  Grid size: " << TILES_X << "x" << TILES_Y << " tiles" << std::endl;
-    std::cout << "  Tile size: " << TILE_SIZE << "x" << TILE_SIZE << " pixels" << std::endl;
-    std::cout << "  Total tiles: " << (TILES_X * TILES_Y) << std::endl;
-    std::cout << "  Current level: " << currentLevel << std::endl;
+    LOG_INFO("Map Info:");
+    LOG_INFO("  Pixel size: " << tilesX * TILE_SIZE << "x" << tilesY * TILE_SIZE);
+    LOG_INFO("  Grid size: " << tilesX << "x" << tilesY << " tiles");
+    LOG_INFO("  Tile size: " << TILE_SIZE << "x" << TILE_SIZE << " pixels");
+    LOG_INFO("  Total tiles: " << (tilesX * tilesY));
+    LOG_INFO("  Current level: " << currentLevel);
 }
\ No newline at end of file
@@ -1,25 +1,52 @@
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <map>
-
-
+#include <array>
+#include <memory>
+#include <span>
+#include "LevelData.h"
+#include "TextureAtlas.h"
 
 class Map {
+public:
+    using TexturePalette = std::array<uint8_t, TILE_TYPE_COUNT>;
+    static constexpr int MAX_TILES = 4096;   // Per side; larger levels are cropped
+
 private:
-    static const int TILE_SIZE = 16;
-    static const int MAP_WIDTH = 224;  // 14 tiles
-    static const int MAP_HEIGHT = 240; // 15 tiles
-    static const int TILES_X = MAP_WIDTH / TILE_SIZE;     // 14 tiles
-    static const int TILES_Y = MAP_HEIGHT / TILE_SIZE;  // 15 tiles
-
-    std::vector<std::vector<int>> tileData;
-    std::vector<sf::Sprite> tileSprites;
-    sf::Texture tileTexture;
-    sf::Sprite tileSprite;
-    std::map<char, int> charToTileType;
-    std::map<int, int> tileTypeToTexture;  // Maps tile type to texture index
+    static constexpr int TILE_SIZE = 16;
+    static constexpr int DEFAULT_TILES_X = 14;   // Grid size before any level is loaded
+    static constexpr int DEFAULT_TILES_Y = 15;
+
+    int tilesX = DEFAULT_TILES_X;   // Grid size, from the level
+    int tilesY = DEFAULT_TILES_Y;
+    std::vector<TileType> tileData;   // Flat row-major grid, tilesX * tilesY
+
+    // Terrain geometry is split into CHUNK_TILES square chunks, built on demand for the
+    // chunks in view, so both build and draw cost follow the screen size rather than the
+    // world size. A built chunk gives every cell a fixed vertex slot, so an edit patches
+    // just that cell's quad and re-uploads just that range.
+    static constexpr int CHUNK_TILES = 32;
+    static constexpr size_t MAX_BUILT_CHUNKS = 64;   // Beyond this, chunks out of view are freed
+    struct Chunk {
+        std::vector<sf::Vertex> vertices;   // Two triangles per cell, row-major; empty cells are collapsed
+        // Created on first draw: a vertex buffer needs a GL context, which headless runs never have
+        std::unique_ptr<sf::VertexBuffer> buffer;
+        bool dirty = true;      // Needs a full build before it can be patched or drawn
+        bool uploaded = false;  // buffer holds the vertices, apart from the patched range
+        bool built = false;     // Listed in builtChunks
+        size_t patchedFirst = 0;   // Vertex range edited since the last upload; empty when first >= last
+        size_t patchedLast = 0;
+    };
+    int chunksX = 0;
+    int chunksY = 0;
+    std::vector<Chunk> chunks;   // Row-major, chunksX * chunksY
+    std::vector<int> builtChunks;   // Chunks currently holding geometry
+    std::vector<std::vector<sf::Vertex>> spareVertices;   // Storage from freed chunks, reused by the next builds
+    sf::IntRect visibleChunks;
+    TextureRegion tileSheet;   // From TextureAtlas; no texture in headless mode
+    TexturePalette tileTypeToTexture;  // Texture index per tile type for the current level
     std::vector<std::pair<char, sf::Vector2f>> entitySpawns;
 
     // Add this to store rock spawn info
@@ -29,25 +56,98 @@ private:
     };
     std::vector<RockSpawnInfo> rockSpawns; // New member to store rock spawn data
 
+public:
+    // Everything a level file determines for one stage: grid, palette, spawn tables and
+    // tunnel index. Built without touching a live Map, so StageManager can
+    // prepare the next stage on a worker thread while the current one is still running.
+    struct Stage {
+        int level = 0;
+        TexturePalette palette{};
+        int tilesX = 0;
+        int tilesY = 0;
+        std::vector<TileType> tileData;
+        std::vector<std::pair<char, sf::Vector2f>> entitySpawns;
+        std::vector<RockSpawnInfo> rockSpawns;
+        std::vector<int32_t> tunnelParent;
+        std::vector<uint8_t> tunnelRank;
+    };
+
+private:
+
     int currentLevel;
+    uint32_t revision = 0;   // Bumped whenever tile data changes
 
-    void buildTiles();
-    void setupTileMappings();
+    // Union-find over Empty cells (-1 for anything else). Digging only ever merges
+    // tunnels, so it is applied in place; filling a cell can split one, so that marks
+    // the index stale and the next query rebuilds it. Mutable for path compression.
+    mutable std::vector<int32_t> tunnelParent;
+    mutable std::vector<uint8_t> tunnelRank;
+    mutable bool tunnelIndexStale = true;
+
+    static constexpr int VERTICES_PER_TILE = 6;
+
+    int tileIndex(int col, int row) const { return row * tilesX + col; }
+    bool inBounds(int col, int row) const { return col >= 0 && col < tilesX && row >= 0 && row < tilesY; }
+    static sf::Vector2f tileCentre(int col, int row) { return sf::Vector2f(col * TILE_SIZE + TILE_SIZE / 2.0f, row * TILE_SIZE + TILE_SIZE / 2.0f); }
+    int textureIndexFor(TileType tileType) const { return tileTypeToTexture[static_cast<uint8_t>(tileType)]; }
+    static const TexturePalette& paletteFor(int level);
+    // texOrigin is the tilesheet's top-left in the bound texture
+    static void writeTile(sf::Vertex* quad, int col, int row, TileType tileType, const TexturePalette& palette, sf::Vector2f texOrigin);
+    void resetChunks();
+    void rebuildChunk(int chunk);
+    void freeChunksOutOfView();
+    void updateTile(int col, int row);
+    void updateTileAndNeighbours(int col, int row);
     void setupTextureMapping();
+    void rebuildTunnelIndex() const;
+    static void buildTunnelIndex(const std::vector<TileType>& tiles, int columns, int rows, std::vector<int32_t>& parent, std::vector<uint8_t>& rank);
+    static int32_t findTunnel(std::vector<int32_t>& parent, int32_t cell);
+    static void uniteTunnels(std::vector<int32_t>& parent, std::vector<uint8_t>& rank, int32_t a, int32_t b);
+    void openTunnelCell(int col, int row);
 
 public:
     Map();
 
+    // Loads a compiled .bmap or an .rmap text level, chosen by extension
     bool loadFromFile(const std::string& filename);
+    void loadLevel(const LevelData& level);
+    // Build a stage from a level file or level data using that level's palette. Static and
+    // free of shared state, so safe to call from any thread.
+    static bool prepareStage(const std::string& filename, int level, Stage& out);
+    static void prepareStage(const LevelData& data, int level, Stage& out);
+    // Make a prepared stage current. Buffers are exchanged, not copied; the stage is left
+    // holding the previous state.
+    void swapStage(Stage& stage);
+    // Dirty every chunk and rebuild the ones in view
+    void buildTiles();
+    // Draws the chunks in the window's current view
     void draw(sf::RenderWindow& window);
+    // World-space area that draw() should cover; rebuilds the dirty chunks in it
+    void setVisibleArea(const sf::FloatRect& area);
+
+    TileType getTileAt(float x, float y) const;
+    void setTileAt(float x, float y, TileType tileType);
+    TileType getTileAtGrid(int gridX, int gridY) const;
+    bool isSolid(float x, float y) const;
 
-    int getTileAt(float x, float y);
-    void setTileAt(float x, float y, int tileType);
-    int getTileAtGrid(int gridX, int gridY);
-    bool isSolid(float x, float y);
+    // Bulk queries: rows are contiguous and returned as a view, columns are copied into out
+    std::span<const TileType> getRow(int row) const;
+    int getColumn(int col, std::span<TileType> out) const;
+
+    static bool isSolidTile(TileType tileType) { return tileType != TileType::Empty && tileType != TileType::OutOfBounds; }
+    static bool isDirt(TileType tileType) { return tileType >= TileType::Dirt1 && tileType <= TileType::Dirt4; }
 
     sf::Vector2i getMapSize() const;
     sf::Vector2i getGridSize() const;
+    static int getTileSize() { return TILE_SIZE; }
+    // Changes whenever any tile changes; lets derived data (e.g. flow fields) skip rebuilds
+    uint32_t getRevision() const { return revision; }
+
+    // True if both points lie in Empty tiles joined by a 4-connected tunnel
+    bool areConnected(sf::Vector2f a, sf::Vector2f b) const;
+    // Representative cell of the tunnel containing the point, or -1 if it is not Empty.
+    // Only stable until the next setTileAt.
+    int getTunnelId(float x, float y) const;
     void printInfo();
 
     const std::vector<std::pair<char, sf::Vector2f>>& getEntitySpawns() const { return entitySpawns; }
@@ -0,0 +1,193 @@
+#include "MappedLevel.h"
+#include "Log.h"
+#include <bit>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedLevel::~MappedLevel() {
+    close();
+}
+
+bool MappedLevel::open(const std::string& filename) {
+    close();
+    static_assert(std::endian::native == std::endian::little, ".bmap files are little-endian");
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("Failed to open compiled map file: " << filename);
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(Bmap::Header))) {
+        LOG_ERROR("Compiled map file is truncated: " << filename);
+        CloseHandle(file);
+        return false;
+    }
+    size = static_cast<size_t>(fileSize.QuadPart);
+    if (size < MAP_THRESHOLD) {
+        buffer.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        DWORD bytesRead = 0;
+        bool ok = ReadFile(file, buffer.data(), static_cast<DWORD>(size), &bytesRead, nullptr) && bytesRead == size;
+        CloseHandle(file);
+        if (!ok) {
+            LOG_ERROR("Failed to read compiled map file: " << filename);
+            buffer.clear();
+            size = 0;
+            return false;
+        }
+        base = reinterpret_cast<const unsigned char*>(buffer.data());
+    }
+    else {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (view == nullptr) {
+            LOG_ERROR("Failed to map compiled map file: " << filename);
+            if (mapping) {
+                CloseHandle(mapping);
+            }
+            CloseHandle(file);
+            size = 0;
+            return false;
+        }
+        fileHandle = file;
+        mappingHandle = mapping;
+        base = static_cast<const unsigned char*>(view);
+        mapped = true;
+    }
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("Failed to open compiled map file: " << filename);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Bmap::Header))) {
+        LOG_ERROR("Compiled map file is truncated: " << filename);
+        ::close(fd);
+        return false;
+    }
+    size = static_cast<size_t>(info.st_size);
+    if (size < MAP_THRESHOLD) {
+        buffer.resize((size + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+        char* out = reinterpret_cast<char*>(buffer.data());
+        size_t done = 0;
+        while (done < size) {
+            ssize_t got = ::read(fd, out + done, size - done);
+            if (got <= 0) {
+                break;
+            }
+            done += static_cast<size_t>(got);
+        }
+        ::close(fd);
+        if (done != size) {
+            LOG_ERROR("Failed to read compiled map file: " << filename);
+            buffer.clear();
+            size = 0;
+            return false;
+        }
+        base = reinterpret_cast<const unsigned char*>(buffer.data());
+    }
+    else {
+        void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);   // The mapping keeps the file referenced
+        if (view == MAP_FAILED) {
+            LOG_ERROR("Failed to map compiled map file: " << filename);
+            size = 0;
+            return false;
+        }
+        base = static_cast<const unsigned char*>(view);
+        mapped = true;
+    }
+#endif
+
+    if (!validate(filename)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedLevel::close() {
+    if (mapped) {
+#ifdef _WIN32
+        UnmapViewOfFile(base);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+#else
+        munmap(const_cast<unsigned char*>(base), size);
+#endif
+    }
+    buffer.clear();
+    mapped = false;
+    base = nullptr;
+    size = 0;
+    level = LevelData();
+}
+
+bool MappedLevel::validate(const std::string& filename) {
+    Bmap::Header header;
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, Bmap::MAGIC, sizeof(Bmap::MAGIC)) != 0) {
+        LOG_ERROR("Not a compiled map file: " << filename);
+        return false;
+    }
+    if (header.version != Bmap::VERSION || header.headerSize != sizeof(Bmap::Header)) {
+        LOG_ERROR("Compiled map file " << filename << " has version " << header.version
+            << ", expected " << Bmap::VERSION << "; recompile it from the .rmap");
+        return false;
+    }
+
+    // Every section must lie inside the file and be aligned for its record type
+    const uint64_t tileBytes = static_cast<uint64_t>(header.width) * header.height;
+    const uint64_t spawnBytes = static_cast<uint64_t>(header.spawnCount) * sizeof(LevelSpawn);
+    const uint64_t rockBytes = static_cast<uint64_t>(header.rockCount) * sizeof(LevelRock);
+    if (header.tilesOffset < sizeof(Bmap::Header) || header.tilesOffset + tileBytes > size || header.spawnsOffset + spawnBytes > size ||
+        header.rocksOffset + rockBytes > size ||
+        header.spawnsOffset % alignof(LevelSpawn) != 0 || header.rocksOffset % alignof(LevelRock) != 0) {
+        LOG_ERROR("Compiled map file is corrupt: " << filename);
+        return false;
+    }
+
+    level.width = header.width;
+    level.height = header.height;
+    level.tiles = { reinterpret_cast<const TileType*>(base + header.tilesOffset), static_cast<size_t>(tileBytes) };
+    level.spawns = { reinterpret_cast<const LevelSpawn*>(base + header.spawnsOffset), header.spawnCount };
+    level.rocks = { reinterpret_cast<const LevelRock*>(base + header.rocksOffset), header.rockCount };
+
+    for (TileType tile : level.tiles) {
+        if (static_cast<int>(tile) >= TILE_TYPE_COUNT) {
+            LOG_ERROR("Compiled map file has an unknown tile type " << static_cast<int>(tile) << ": " << filename);
+            return false;
+        }
+    }
+    for (const LevelSpawn& spawn : level.spawns) {
+        if (spawn.col >= level.width || spawn.row >= level.height) {
+            LOG_ERROR("Compiled map file has a spawn outside the grid: " << filename);
+            return false;
+        }
+    }
+    for (const LevelRock& rock : level.rocks) {
+        if (rock.col >= level.width || rock.row >= level.height) {
+            LOG_ERROR("Compiled map file has a rock outside the grid: " << filename);
+            return false;
+        }
+        if (static_cast<int>(rock.textureSource) >= TILE_TYPE_COUNT) {
+            LOG_ERROR("Compiled map file has a rock with an unknown tile type " << static_cast<int>(rock.textureSource) << ": " << filename);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "LevelData.h"
+
+// A compiled .bmap level mapped read-only into memory. The LevelData view points
+// straight into the mapping: opening validates the header and section bounds, but
+// nothing is parsed or copied. The view is valid until close() or destruction.
+// Files under MAP_THRESHOLD are read into a buffer instead, since for a few hundred
+// bytes the map/unmap system calls cost more than the copy.
+class MappedLevel {
+public:
+    MappedLevel() = default;
+    ~MappedLevel();
+    MappedLevel(const MappedLevel&) = delete;
+    MappedLevel& operator=(const MappedLevel&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+    const LevelData& data() const { return level; }
+
+    static const size_t MAP_THRESHOLD = 64 * 1024;
+
+private:
+    const unsigned char* base = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::vector<uint64_t> buffer;   // Small files; uint64_t keeps the sections aligned
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+    LevelData level;
+
+    bool validate(const std::string& filename);
+};
@@ -1,14 +1,16 @@
 
-#include <iostream>
 #include <cmath>
 #include "Player.h"
+#include "Log.h"
 #include "Math.h"
 #include "GameState.h"
+#include "TextureAtlas.h"
+#include "Profiler.h"
 
 Player::Player(Map* gameMap) : Entity(EntityType::PLAYER, true, sf::Vector2i(16, 16)),
-health(1), lives(1), score(0), speed(40.0f), sprite(texture),
+health(1), lives(1), score(0), speed(40.0f),
 isShooting(false), shootDirection(0, 0), harpoonSpeed(150.0f), maxHarpoonLength(32.0f),
-currentHarpoonLength(0.0f), harpoonSprite(harpoonTexture), map(gameMap), createTunnels(true),
+currentHarpoonLength(0.0f), map(gameMap), createTunnels(true),
 harpoonSound("Assets/Sounds/SFX/pump.mp3", SFX::Type::SOUND), MovementMusic("Assets/Sounds/Music/walkingnormal.mp3", SFX::Type::MUSIC), harpoonTimer(0)
 {
 }
@@ -21,16 +23,16 @@ void Player::Initialise() {
 }
 
 void Player::Load() {
-    if (!texture.loadFromFile("Assets/Sprites/Player/spritesheet1.png")) {
-        std::cout << "failed to load player sprite" << '\n';
+    spriteSheet = TextureAtlas::GetRegion("Assets/Sprites/Player/spritesheet1.png");
+    if (spriteSheet.texture) {
+        sprite.setTexture(*spriteSheet.texture);
     }
-    sprite.setTexture(texture);
-    sprite.setTextureRect(sf::IntRect({ 0, 0 }, { size.x, size.y }));
-
-    if (!harpoonTexture.loadFromFile("Assets/Sprites/Player/harpoon.png")) {
-        std::cout << "failed to load harpoon sprite, using fallback" << '\n';
+    harpoonImage = TextureAtlas::GetRegion("Assets/Sprites/Player/harpoon.png");
+    if (harpoonImage.texture) {
+        harpoonSprite.setTexture(*harpoonImage.texture);
+        harpoonSprite.setTextureRect(harpoonImage.bounds());
     }
-    harpoonSprite.setTexture(harpoonTexture);
+    sprite.setTextureRect(spriteSheet.map(sf::IntRect({ 0, 0 }, { size.x, size.y })));
     harpoonSprite.setOrigin(sf::Vector2f(2, 2));
 
     setPosition(initialPos);
@@ -39,8 +41,8 @@ void Player::Load() {
     sprite.setOrigin(sf::Vector2f(size.x / 2.0f, size.y / 2.0f));
     sprite.setScale(sf::Vector2f(1, 1));
 
-    std::cout << "player loaded successfully" << '\n';
-    animation = std::make_unique<Animation>(&texture, sf::Vector2u(4, 3), 0.25f, size.x, size.y, true);
+    LOG_DEBUG("player loaded successfully");
+    animation = std::make_unique<Animation>(spriteSheet.offset, sf::Vector2u(4, 3), 0.25f, size.x, size.y, true);
 
     MovementMusic.setVolume(30);
     MovementMusic.setLoop(true);
@@ -57,10 +59,13 @@ void Player::setPosition(sf::Vector2f pos) {
 
     // Update sprite position to match
     sprite.setPosition(pos);
-    std::cout << "Player position set to (" << pos.x << ", " << pos.y << ")" << std::endl;
+    sprite.storePreviousPosition();
+    LOG_DEBUG("Player position set to (" << pos.x << ", " << pos.y << ")");
 }
 
 void Player::Update(float deltaTime, sf::Vector2f playerPosition) {
+    PROFILE_SCOPE("Player::Update");
+    sprite.storePreviousPosition();
 
     // Handle immobilization timer regardless of state
     if (isImmobilized) {
@@ -68,7 +73,7 @@ void Player::Update(float deltaTime, sf::Vector2f playerPosition) {
         if (immobilizationTimer >= IMMOBILIZATION_DURATION) {
             isImmobilized = false;
             immobilizationTimer = 0.0f;
-            std::cout << "Player can move again!" << std::endl;
+            LOG_DEBUG("Player can move again!");
         }
     }
 
@@ -163,25 +168,23 @@ void Player::updateGameState(float deltaTime, sf::Vector2f playerPosition) {
         if (immobilizationTimer >= IMMOBILIZATION_DURATION) {
             isImmobilized = false;
             immobilizationTimer = 0.0f;
-            std::cout << "Player can move again!" << std::endl;
+            LOG_DEBUG("Player can move again!");
         }
     }
 
     // Handle space key for shooting/pumping
-    bool spaceCurrentlyPressed = sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Space);
+    bool spaceCurrentlyPressed = input.isDown(InputState::FIRE);
     if (spaceCurrentlyPressed && !spaceKeyPressed) {
-        if (harpoonedEnemy) {
-            std::cout << "Pumping harpooned enemy!" << std::endl;
-            harpoonedEnemy->Inflate();
+        if (Entity::IsValid(harpoonedEnemy)) {
+            LOG_DEBUG("Pumping harpooned enemy!");
+            enemyManager->InflateEnemy(harpoonedEnemy);
             harpoonSound.play();
             animation->currentImage.x++;
             if (animation->currentImage.x >= animation->imageCount.x) {
                 animation->currentImage.x = 0;
             }
             animation->currentImage.y = 1;
-            animation->uvRect.position = sf::Vector2i(animation->currentImage.x * animation->uvRect.size.x,
-                animation->currentImage.y * animation->uvRect.size.y);
-            sprite.setTextureRect(animation->uvRect);
+            animation->ApplyFrame(sprite);
         }
         else if (!isShooting && !isMoving && !isImmobilized) {
             harpoonSound.play();
@@ -199,42 +202,42 @@ void Player::updateGameState(float deltaTime, sf::Vector2f playerPosition) {
     // This uses the same 'movementAttempted' check structure you had, but ensures it runs
     // even if the player is technically "not moving" due to being harpooned.
     bool movementAttemptedThisFrame = false; // New flag to track if any movement key was pressed
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+    if (input.isDown(InputState::LEFT)) {
         movementAttemptedThisFrame = true;
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+    else if (input.isDown(InputState::RIGHT)) {
         movementAttemptedThisFrame = true;
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
+    else if (input.isDown(InputState::UP)) {
         movementAttemptedThisFrame = true;
     }
-    else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
+    else if (input.isDown(InputState::DOWN)) {
         movementAttemptedThisFrame = true;
     }
 
-    if (movementAttemptedThisFrame && harpoonedEnemy) { // If a movement key was pressed AND an enemy is harpooned
-        std::cout << "Movement key pressed - detaching harpoon!" << std::endl;
+    if (movementAttemptedThisFrame && Entity::IsValid(harpoonedEnemy)) { // If a movement key was pressed AND an enemy is harpooned
+        LOG_DEBUG("Movement key pressed - detaching harpoon!");
         DetachHarpoon();
         return; // Exit update early as player just detached and might start moving next frame
     }
 
-    else if (!isMoving && !isImmobilized && !harpoonedEnemy) { 
+    else if (!isMoving && !isImmobilized && !Entity::IsValid(harpoonedEnemy)) { 
         sf::Vector2f newTarget = targetPosition;
         bool movementAttempted = false; 
 
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::A)) {
+        if (input.isDown(InputState::LEFT)) {
             newTarget.x -= TILE_SIZE;
             movementAttempted = true;
         }
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::D)) {
+        else if (input.isDown(InputState::RIGHT)) {
             newTarget.x += TILE_SIZE;
             movementAttempted = true;
         }
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::W)) {
+        else if (input.isDown(InputState::UP)) {
             newTarget.y -= TILE_SIZE;
             movementAttempted = true;
         }
-        else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::S)) {
+        else if (input.isDown(InputState::DOWN)) {
             newTarget.y += TILE_SIZE;
             movementAttempted = true;
         }
@@ -246,9 +249,9 @@ void Player::updateGameState(float deltaTime, sf::Vector2f playerPosition) {
     }
 
 
-    if (isMoving && (isImmobilized || harpoonedEnemy)) {
+    if (isMoving && (isImmobilized || Entity::IsValid(harpoonedEnemy))) {
         isMoving = false;
-        std::cout << "Movement stopped due to immobilization or harpooned enemy" << std::endl;
+        LOG_DEBUG("Movement stopped due to immobilization or harpooned enemy");
     }
 
     // Handle movement and sprite orientation
@@ -307,13 +310,13 @@ void Player::updateGameState(float deltaTime, sf::Vector2f playerPosition) {
     if (isMoving && !wasMoving) {
         if (MovementMusic.isPlaying() == false) {
             MovementMusic.play();
-            std::cout << "Started moving - playing music" << std::endl;
+            LOG_DEBUG("Started moving - playing music");
         }
     }
     else if (!isMoving && wasMoving) {
         if (MovementMusic.isPlaying() != false) {
             MovementMusic.pause();
-            std::cout << "Stopped moving - pausing music" << std::endl;
+            LOG_DEBUG("Stopped moving - pausing music");
         }
     }
 }
@@ -328,7 +331,7 @@ void Player::updateWinState(float deltaTime, sf::Vector2f playerPosition) {
     }
 
     // Detach any harpooned enemies
-    if (harpoonedEnemy) {
+    if (Entity::IsValid(harpoonedEnemy)) {
         DetachHarpoon();
     }
 
@@ -345,7 +348,7 @@ void Player::updateLossState(float deltaTime, sf::Vector2f playerPosition)
         animation->ResetAnimation();
         animation->SetLooping(false); // Death animation should not loop
         deathAnimationStarted = true;
-        std::cout << "Death animation started" << std::endl;
+        LOG_DEBUG("Death animation started");
     }
     MovementMusic.stop();
 
@@ -355,7 +358,7 @@ void Player::updateLossState(float deltaTime, sf::Vector2f playerPosition)
     if (isShooting) {
         stopShooting();
     }
-    if (harpoonedEnemy) {
+    if (Entity::IsValid(harpoonedEnemy)) {
         DetachHarpoon();
     }
     isMoving = false;
@@ -369,7 +372,7 @@ void Player::startShooting() {
         shootDirection = sf::Vector2f(1, 0);
     }
     harpoonStartPos = sprite.getPosition();
-    std::cout << "Started shooting in direction: " << shootDirection.x << ", " << shootDirection.y << std::endl;
+    LOG_DEBUG("Started shooting in direction: " << shootDirection.x << ", " << shootDirection.y);
 }
 
 void Player::updateShooting(float deltaTime) {
@@ -396,60 +399,56 @@ void Player::updateShooting(float deltaTime) {
     harpoonHitbox.setOrigin(sf::Vector2f(harpoonSize.x / 2.0f, harpoonSize.y / 2.0f));
 
     if (map != nullptr) {
-        int tileType = map->getTileAt(harpoonEndPos.x, harpoonEndPos.y);
-        if (tileType == 1 || tileType == 2 || tileType == 3 || tileType == 4 || tileType == 5) {
+        if (Map::isSolidTile(map->getTileAt(harpoonEndPos.x, harpoonEndPos.y))) {
             hitWall = true;
         }
     }
 
-    if (enemyManager != nullptr && !harpoonedEnemy) {
-        for (auto& enemy : enemyManager->GetEnemies()) {
-            if (enemy && enemy->isActive()) {
-                sf::FloatRect enemyBounds = enemy->getBounds();
-                sf::FloatRect harpoonBounds = harpoonHitbox.getGlobalBounds();
-                if (harpoonBounds.findIntersection(enemyBounds)) {
-                    std::cout << "Enemy harpooned at (" << enemyBounds.position.x << ", " << enemyBounds.position.y << ")" << std::endl;
-                    harpoonedEnemy = enemy;
-                    animation->Update(1, deltaTime, sprite);
-                    enemy->AttachHarpoon();
-                    isImmobilized = true;
-                    immobilizationTimer = 0.0f;
-                    std::cout << "Player immobilized for " << IMMOBILIZATION_DURATION << " seconds" << std::endl;
-                    return;
-                }
-            }
+    if (enemyManager != nullptr && !Entity::IsValid(harpoonedEnemy)) {
+        std::vector<EntityID> hits;
+        enemyManager->QueryEnemies(harpoonHitbox.getGlobalBounds(), hits);
+        if (!hits.empty()) {
+            EntityID enemy = hits.front();
+            LOG_DEBUG("Enemy " << enemy << " harpooned");
+            harpoonedEnemy = enemy;
+            animation->Update(1, deltaTime, sprite);
+            enemyManager->AttachHarpoon(enemy);
+            isImmobilized = true;
+            immobilizationTimer = 0.0f;
+            LOG_DEBUG("Player immobilized for " << IMMOBILIZATION_DURATION << " seconds");
+            return;
         }
     }
 
     if (currentHarpoonLength >= maxHarpoonLength || hitWall) {
-        std::cout << "Stopping harpoon - Length: " << currentHarpoonLength << ", Max: " << maxHarpoonLength << ", Hit wall: " << hitWall << std::endl;
+        LOG_DEBUG("Stopping harpoon - Length: " << currentHarpoonLength << ", Max: " << maxHarpoonLength << ", Hit wall: " << hitWall);
         stopShooting();
     }
 }
 
 void Player::stopShooting() {
-    std::cout << "stopShooting() called" << std::endl;
+    LOG_DEBUG("stopShooting() called");
     isShooting = false;
     currentHarpoonLength = 0.0f;
-    if (!harpoonedEnemy) {
-        std::cout << "Harpoon stopped without hitting enemy" << std::endl;
+    if (!Entity::IsValid(harpoonedEnemy)) {
+        LOG_DEBUG("Harpoon stopped without hitting enemy");
     }
     else {
-        std::cout << "Harpoon attached to enemy, keeping connection" << std::endl;
+        LOG_DEBUG("Harpoon attached to enemy, keeping connection");
     }
-    std::cout << "Shooting stopped, isShooting = " << isShooting << std::endl;
+    LOG_DEBUG("Shooting stopped, isShooting = " << isShooting);
 }
 
 void Player::createTunnel(sf::Vector2f position) {
     if (map != nullptr && createTunnels) {
-        int tileType = map->getTileAt(position.x, position.y);
-        if (tileType == 2 || tileType == 3 || tileType == 4 || tileType == 5) {
-            map->setTileAt(position.x, position.y, 0);
+        TileType tileType = map->getTileAt(position.x, position.y);
+        if (Map::isDirt(tileType)) {
+            map->setTileAt(position.x, position.y, TileType::Empty);
             if (gameState && gameState->getGameState() != States::START) {
-                if (tileType == 2) score += 10;
-                if (tileType == 3) score += 20;
-                if (tileType == 4) score += 30;
-                if (tileType == 5) score += 40; 
+                if (tileType == TileType::Dirt1) score += 10;
+                if (tileType == TileType::Dirt2) score += 20;
+                if (tileType == TileType::Dirt3) score += 30;
+                if (tileType == TileType::Dirt4) score += 40;
             }
         }
     }
@@ -458,13 +457,14 @@ void Player::createTunnel(sf::Vector2f position) {
 void Player::Draw(sf::RenderWindow& window) {
     window.draw(sprite);
     window.draw(hitbox);
-    if (isShooting || harpoonedEnemy) {
+    if (isShooting || Entity::IsValid(harpoonedEnemy)) {
         sf::RectangleShape harpoonLine;
-        if (harpoonedEnemy) {
-            sf::Vector2f enemyPos = harpoonedEnemy->getBounds().position;
-            enemyPos.x += harpoonedEnemy->getBounds().size.x / 2.0f;
-            enemyPos.y += harpoonedEnemy->getBounds().size.y / 2.0f;
+        if (Entity::IsValid(harpoonedEnemy)) {
             sf::Vector2f playerPos = sprite.getPosition();
+            sf::FloatRect enemyBounds = enemyManager->GetEnemyBounds(harpoonedEnemy).value_or(sf::FloatRect(playerPos, { 0, 0 }));
+            sf::Vector2f enemyPos = enemyBounds.position;
+            enemyPos.x += enemyBounds.size.x / 2.0f;
+            enemyPos.y += enemyBounds.size.y / 2.0f;
             sf::Vector2f direction = enemyPos - playerPos;
             float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
 
@@ -519,15 +519,15 @@ bool Player::isCurrentlyShooting() const {
 }
 
 void Player::shoot() {
-    if (!isShooting && !isMoving && !isImmobilized && !harpoonedEnemy) {
+    if (!isShooting && !isMoving && !isImmobilized && !Entity::IsValid(harpoonedEnemy)) {
         startShooting();
     }
 }
 
 void Player::DetachHarpoon() {
-    if (harpoonedEnemy) {
-        std::cout << "Player harpoon detached from enemy" << std::endl;
-        harpoonedEnemy = nullptr;
+    if (Entity::IsValid(harpoonedEnemy)) {
+        LOG_DEBUG("Player harpoon detached from enemy");
+        harpoonedEnemy = INVALID_ENTITY;
         isImmobilized = false;
         immobilizationTimer = 0.0f;
         isShooting = false;
@@ -538,5 +538,5 @@ void Player::DetachHarpoon() {
 
 void Player::resetDeathAnimation() {
     deathAnimationStarted = false;
-    std::cout << "Death animation reset" << std::endl;
+    LOG_DEBUG("Death animation reset");
 }
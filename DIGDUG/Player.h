@@ -1,11 +1,12 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
 #include "Entity.h"
 #include "Map.h"
 #include "Animation.h"
+#include "TextureAtlas.h"
 #include "EnemyManager.h"
 #include "SFX.h"
+#include "Input.h"
 
 class GameState;
 class EnemyManager;
@@ -18,8 +19,8 @@ private:
     int score;
     float speed;
 
-    sf::Sprite sprite;
-    sf::Texture texture;
+    GameSprite sprite;
+    TextureRegion spriteSheet;   // From TextureAtlas; no texture in headless mode
     // sound + start
     sf::Vector2f initialPos;
     SFX MovementMusic;
@@ -27,7 +28,7 @@ private:
 
     // enemy manager
     EnemyManager* enemyManager = nullptr;
-    std::shared_ptr<Entity> harpoonedEnemy = nullptr;
+    EntityID harpoonedEnemy = INVALID_ENTITY;
 
     //shooting
     bool isShooting;
@@ -41,10 +42,11 @@ private:
     float currentHarpoonLength;
     float harpoonTimer;
     const float HARPOON_DURATION = 3.0f;
-    sf::Texture harpoonTexture;
-    sf::Sprite harpoonSprite;
+    TextureRegion harpoonImage;
+    GameSprite harpoonSprite;
     sf::RectangleShape harpoonHitbox;
     bool spaceKeyPressed = false;
+    InputState input;   // This tick's input, fed in by Game
     // immobolisation
     bool isImmobilized = false;
     float immobilizationTimer = 0.0f;
@@ -74,7 +76,9 @@ public:
     bool getInflationStatus() override {return 0;}
 
     void SetEnemyManager(EnemyManager* manager) { enemyManager = manager; }
+    void SetInput(const InputState& state) { input = state; }
     sf::Vector2f getPlayerPosition() { return sprite.getPosition(); }
+    sf::Vector2f getDrawPosition() const { return sprite.getDrawPosition(); }
     void setPlayerInitialPosition(sf::Vector2f initialpos) {
         initialPos.x = ((int)initialpos.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
         initialPos.y = ((int)initialpos.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
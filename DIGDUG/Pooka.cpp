@@ -1,379 +1,417 @@
-
-#include <iostream>
 #include <cmath>
 #include <vector>
 #include <algorithm>
 #include "Pooka.h"
+#include "Log.h"
+#include "Map.h"
 #include "Player.h"
+#include "TextureAtlas.h"
+#include "GameSprite.h"
+#include "Random.h"
+#include "FlowField.h"
+#include "Profiler.h"
+
+PookaStore::PookaStore(Map* gameMap, Player* player, Random* random)
+    : map(gameMap), player(player), rng(random), spriteVertices(sf::PrimitiveType::Triangles) {
+    hitboxShape.setFillColor(sf::Color::Transparent);
+    hitboxShape.setOutlineColor(sf::Color::Red);
+    hitboxShape.setOutlineThickness(1);
+}
+
+void PookaStore::Load() {
+    // Shared by every Pooka; decoded once for the whole session
+    spriteSheet = TextureAtlas::GetRegion("Assets/Sprites/Pooka/spritesheet.png");
+}
+
+void PookaStore::Reserve(size_t count) {
+    slots.Reserve(count);
+    alive.reserve(count);
+    health.reserve(count);
+    position.reserve(count);
+    previousPosition.reserve(count);
+    target.reserve(count);
+    moving.reserve(count);
+    ghost.reserve(count);
+    movementTimer.reserve(count);
+    movementDelay.reserve(count);
+    stuckTimer.reserve(count);
+    ghostModeDelay.reserve(count);
+    harpoonStuck.reserve(count);
+    pumpState.reserve(count);
+    pumpTimer.reserve(count);
+    pumpCooldownTimer.reserve(count);
+    scale.reserve(count);
+    animationRow.reserve(count);
+    animationFrame.reserve(count);
+    animationTime.reserve(count);
+    hitboxEnabled.reserve(count);
+}
 
-Pooka::Pooka(Map* gameMap, Player* player) : Entity(EntityType::POOKA, true, sf::Vector2i(16, 16)),
-health(4), speed(15.0f), status(0), sprite(texture), pumpSound(pumpBuffer), map(gameMap), player(player) {
+EntityID PookaStore::Spawn(sf::Vector2f pos) {
+    // Snap to grid for tile-based movement
+    pos.x = ((int)pos.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
+    pos.y = ((int)pos.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
 
+    EntityID id = slots.Add();
+    alive.push_back(1);
+    health.push_back(MAX_HEALTH);
+    position.push_back(pos);
+    previousPosition.push_back(pos);
+    target.push_back(pos);
+    moving.push_back(0);
+    ghost.push_back(0);
+    movementTimer.push_back(0.0f);
+    movementDelay.push_back(1.0f);
+    stuckTimer.push_back(0.0f);
+    ghostModeDelay.push_back(rng->Range(2.0f, 7.0f));
+    harpoonStuck.push_back(0);
+    pumpState.push_back(0);
+    pumpTimer.push_back(0.0f);
+    pumpCooldownTimer.push_back(0.0f);
+    scale.push_back({ 1.0f, 1.0f });
+    animationRow.push_back(0);
+    animationFrame.push_back(0);
+    animationTime.push_back(0.0f);
+    hitboxEnabled.push_back(1);
+    return id;
 }
 
-void Pooka::Initialise() {
-    Entity::Initialise();
+void PookaStore::Clear() {
+    slots.Clear();
+    alive.clear();
+    health.clear();
+    position.clear();
+    previousPosition.clear();
+    target.clear();
+    moving.clear();
+    ghost.clear();
+    movementTimer.clear();
+    movementDelay.clear();
+    stuckTimer.clear();
+    ghostModeDelay.clear();
+    harpoonStuck.clear();
+    pumpState.clear();
+    pumpTimer.clear();
+    pumpCooldownTimer.clear();
+    scale.clear();
+    animationRow.clear();
+    animationFrame.clear();
+    animationTime.clear();
+    hitboxEnabled.clear();
 }
 
-void Pooka::Load() {
-    if (!texture.loadFromFile("Assets/Sprites/Pooka/spritesheet.png")) {
-        std::cout << "failed to load pooka sprite" << '\n';
+namespace {
+    template <typename T>
+    void swapRemove(std::vector<T>& values, size_t i) {
+        values[i] = values.back();
+        values.pop_back();
     }
-    sprite.setTexture(texture);
-    sprite.setTextureRect(sf::IntRect({ 0, 0 }, { size.x, size.y }));
-    sprite.setOrigin(sf::Vector2f(size.x / 2.0f, size.y / 2.0f));
-    sprite.setScale(sf::Vector2f(1, 1));
-    sprite.setPosition({ 0, 0 }); // default pos
+}
+
+void PookaStore::removeAt(size_t i) {
+    slots.RemoveAt(i);
+    swapRemove(alive, i);
+    swapRemove(health, i);
+    swapRemove(position, i);
+    swapRemove(previousPosition, i);
+    swapRemove(target, i);
+    swapRemove(moving, i);
+    swapRemove(ghost, i);
+    swapRemove(movementTimer, i);
+    swapRemove(movementDelay, i);
+    swapRemove(stuckTimer, i);
+    swapRemove(ghostModeDelay, i);
+    swapRemove(harpoonStuck, i);
+    swapRemove(pumpState, i);
+    swapRemove(pumpTimer, i);
+    swapRemove(pumpCooldownTimer, i);
+    swapRemove(scale, i);
+    swapRemove(animationRow, i);
+    swapRemove(animationFrame, i);
+    swapRemove(animationTime, i);
+    swapRemove(hitboxEnabled, i);
+}
 
+size_t PookaStore::RemoveDead() {
+    size_t removed = 0;
+    for (size_t i = 0; i < Size();) {
+        if (alive[i]) {
+            i++;
+            continue;
+        }
+        // The last Pooka moves into slot i, so look at i again
+        removeAt(i);
+        removed++;
+    }
+    return removed;
+}
 
-    if (!pumpBuffer.loadFromFile("Assets/Sounds/SFX/pump.mp3")) {
-        std::cout << "failed to load pump sound" << '\n';
+sf::FloatRect PookaStore::GetBounds(size_t i) const {
+    // Matches the global bounds of the old 10x10 hitbox with its 1px outline;
+    // a disabled hitbox is a zero-size rect that never intersects anything
+    if (hitboxEnabled[i]) {
+        return sf::FloatRect(position[i] - sf::Vector2f(6.0f, 6.0f), { 12.0f, 12.0f });
     }
-    pumpSound.setBuffer(pumpBuffer);
+    return sf::FloatRect(position[i] - sf::Vector2f(5.0f, 5.0f), { 0.0f, 0.0f });
+}
 
-    std::cout << "pooka loaded successfully" << '\n';
-    animation = std::make_unique<Animation>(&texture, sf::Vector2u(2, 2), 0.25f, size.x, size.y, true);
+bool PookaStore::canAct(size_t i) const {
+    return alive[i] && health[i] > 0 && pumpState[i] == 0 && !harpoonStuck[i];
 }
 
-void Pooka::Update(float deltaTime, sf::Vector2f playerPosition) {
-    if (health <= 0 || !isAlive) return;
-
-    // Handle pump state deflation
-    if (harpoonStuck) { 
-        pumpTimer += deltaTime;
-        if (pumpTimer >= PUMP_DURATION) {
-            if (pumpState > 0) { // Only deflate if pumpState is greater than 0
-                pumpState = std::max(0, pumpState - 1); // Deflate one level
-                std::cout << "Pooka deflated to state: " << pumpState << std::endl;
-               
-                if (pumpState == 0) {
-                    if (health < 4) { // Assuming 4 is max health
-                        health += 1;
-                        std::cout << "Pooka health regen to: " << health << std::endl;
+void PookaStore::Update(float deltaTime, sf::Vector2f playerPosition, const FlowField& flowField) {
+    PROFILE_SCOPE("PookaStore::Update");
+    const size_t count = Size();
+    std::copy(position.begin(), position.end(), previousPosition.begin());
+
+    // Pump deflation and cooldowns
+    for (size_t i = 0; i < count; i++) {
+        if (health[i] <= 0 || !alive[i]) continue;
+
+        if (harpoonStuck[i]) {
+            pumpTimer[i] += deltaTime;
+            if (pumpTimer[i] >= PUMP_DURATION) {
+                if (pumpState[i] > 0) { // Only deflate if pumpState is greater than 0
+                    pumpState[i]--; // Deflate one level
+                    LOG_DEBUG("Pooka deflated to state: " << static_cast<int>(pumpState[i]));
+
+                    if (pumpState[i] == 0) {
+                        if (health[i] < MAX_HEALTH) {
+                            health[i]++;
+                            LOG_DEBUG("Pooka health regen to: " << static_cast<int>(health[i]));
+                        }
+                        DetachHarpoon(i); // Detach when fully deflated
                     }
-                    DetachHarpoon(); // Detach when fully deflated
                 }
+                else {
+                    DetachHarpoon(i);
+                }
+                pumpTimer[i] = 0.0f;
+                updateInflationSprite(i);
             }
-            else {
-                DetachHarpoon();
-            }
-            pumpTimer = 0.0f;
-            updateInflationSprite();
         }
-    }
 
+        if (pumpCooldownTimer[i] > 0.0f) {
+            pumpCooldownTimer[i] -= deltaTime;
+        }
+    }
 
-    if (pumpCooldownTimer > 0.0f) {
-        pumpCooldownTimer -= deltaTime;
+    // Everything below only concerns free-roaming Pookas; gather them once
+    activeScratch.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (canAct(i)) {
+            activeScratch.push_back(static_cast<uint32_t>(i));
+        }
     }
 
-    if (health > 0 && isAlive && pumpState == 0 && !harpoonStuck) {
-        sf::Vector2f currentPosition = sprite.getPosition();
-        movementTimer += deltaTime;
-        stuckTimer += deltaTime;
+    // Timers, then pick a new target tile for idle Pookas whose delay has elapsed.
+    // Runs in index order so the shared RNG is consumed exactly as before.
+    for (uint32_t i : activeScratch) {
+        movementTimer[i] += deltaTime;
+        stuckTimer[i] += deltaTime;
+        if (!moving[i] && movementTimer[i] >= movementDelay[i]) {
+            movementTimer[i] = 0.0f;
+            movementDelay[i] = rng->Range(0.3f, 1.0f);
+            chooseTarget(i, playerPosition, flowField);
+        }
+    }
 
-        if (!isMoving) {
-            sf::Vector2f newTarget = targetPosition;
+    for (uint32_t i : activeScratch) {
+        moveTowardsTarget(i, deltaTime);
+        if (moving[i]) {
+            animate(i, deltaTime);
+        }
+    }
+}
 
-            if (movementTimer >= movementDelay) {
-                movementTimer = 0.0f;
-                movementDelay = 0.3f + static_cast<float>(rand()) / RAND_MAX * 0.7f;
+void PookaStore::chooseTarget(size_t i, sf::Vector2f playerPosition, const FlowField& flowField) {
+    const sf::Vector2f currentPosition = position[i];
+    const sf::Vector2f targetPosition = target[i];
+    sf::Vector2f newTarget = targetPosition;
+    sf::Vector2f directionToPlayer = playerPosition - currentPosition;
+    bool foundValidMove = false;
+
+    if (ghost[i]) {
+        // Ghost mode - move directly toward player
+        if (std::abs(directionToPlayer.y) >= std::abs(directionToPlayer.x)) {
+            newTarget.y += (directionToPlayer.y < 0) ? -TILE_SIZE : TILE_SIZE;
+            scale[i] = { 1, 1 };
+        }
+        else {
+            newTarget.x += (directionToPlayer.x < 0) ? -TILE_SIZE : TILE_SIZE;
+            scale[i] = { (directionToPlayer.x < 0) ? -1.0f : 1.0f, 1 };
+        }
+        foundValidMove = true;
+    }
+    else {
+        // Follow the shared flow field along the tunnels towards the player
+        sf::Vector2i step = flowField.StepFrom(currentPosition);
+        if (step != sf::Vector2i(0, 0)) {
+            newTarget.x += step.x * TILE_SIZE;
+            newTarget.y += step.y * TILE_SIZE;
+            foundValidMove = canMoveTo(i, newTarget);
+            if (foundValidMove) {
+                stuckTimer[i] = 0.0f;
+            }
+        }
+        // Also reached when the step leads into dirt, e.g. the player standing in an undug cell
+        if (!foundValidMove && stuckTimer[i] >= ghostModeDelay[i] && !map->areConnected(currentPosition, playerPosition)) {
+            // Cut off from the player by dirt for too long: drift through it
+            ghost[i] = 1;
+            stuckTimer[i] = 0.0f;
+            newTarget = targetPosition;
+            foundValidMove = true;
+        }
 
-                sf::Vector2f directionToPlayer = playerPosition - currentPosition;
-                bool foundValidMove = false;
+        // Random movement if no valid pathfinding move
+        if (!foundValidMove) {
+            newTarget = targetPosition;
+            float first = rng->NextBool() ? -TILE_SIZE : TILE_SIZE;
+            newTarget.y = targetPosition.y + first;
+            foundValidMove = canMoveTo(i, newTarget);
+            if (!foundValidMove) {
+                newTarget.y = targetPosition.y - first;
+                foundValidMove = canMoveTo(i, newTarget);
+            }
+        }
+    }
 
-                if (status == 1) {
-                    // Ghost mode - move directly toward player
-                    if (abs(directionToPlayer.y) >= abs(directionToPlayer.x)) {
-                        if (directionToPlayer.y < 0) {
-                            newTarget.y -= TILE_SIZE;
-                            sprite.setScale(sf::Vector2f(1, 1));
-                        }
-                        else {
-                            newTarget.y += TILE_SIZE;
-                            sprite.setScale(sf::Vector2f(1, 1));
-                        }
-                    }
-                    else {
-                        if (directionToPlayer.x < 0) {
-                            newTarget.x -= TILE_SIZE;
-                            sprite.setScale(sf::Vector2f(-1, 1));
-                        }
-                        else {
-                            newTarget.x += TILE_SIZE;
-                            sprite.setScale(sf::Vector2f(1, 1));
-                        }
-                    }
-                    foundValidMove = true;
-                }
-                else {
-                    // pathfinding logic
-                    int currentTileType = map->getTileAt(currentPosition.x, currentPosition.y);
-                    int playerTileType = map->getTileAt(playerPosition.x, playerPosition.y);
-
-                    bool canSeePlayer = (currentTileType == 0 && playerTileType == 0);
-
-                    if (canSeePlayer) {
-                        // Pathfind toward player
-                        if (abs(directionToPlayer.y) > TILE_SIZE / 2) {
-                            if (directionToPlayer.y < 0) {
-                                newTarget.y -= TILE_SIZE;
-                                if (canMoveTo(newTarget)) {
-                                 
-                                    foundValidMove = true;
-                                }
-                            }
-                            else {
-                                newTarget.y += TILE_SIZE;
-                                if (canMoveTo(newTarget)) {
-                                   
-                                    foundValidMove = true;
-                                }
-                            }
-                        }
+    if (foundValidMove && newTarget != targetPosition) {
+        target[i] = newTarget;
+        moving[i] = 1;
+    }
+}
 
-                        if (!foundValidMove && abs(directionToPlayer.x) > TILE_SIZE / 2) {
-                            newTarget = targetPosition;
-                            if (directionToPlayer.x < 0) {
-                                newTarget.x -= TILE_SIZE;
-                                if (canMoveTo(newTarget)) {
-                                    
-                                    foundValidMove = true;
-                                }
-                            }
-                            else {
-                                newTarget.x += TILE_SIZE;
-                                if (canMoveTo(newTarget)) {
-                                    
-                                    foundValidMove = true;
-                                }
-                            }
-                        }
+void PookaStore::moveTowardsTarget(size_t i, float deltaTime) {
+    if (!moving[i]) return;
 
-                        if (!foundValidMove && stuckTimer >= ghostModeDelay) {
-                            sf::Vector2f bestMove = targetPosition;
-                            if (abs(directionToPlayer.y) >= abs(directionToPlayer.x)) {
-                                bestMove.y += (directionToPlayer.y < 0) ? -TILE_SIZE : TILE_SIZE;
-                            }
-                            else {
-                                bestMove.x += (directionToPlayer.x < 0) ? -TILE_SIZE : TILE_SIZE;
-                            }
-
-                            if (!canMoveTo(bestMove)) {
-                                status = 1;
-                                stuckTimer = 0.0f;
-                                foundValidMove = true;
-                            }
-                        }
-                    }
+    sf::Vector2f direction = target[i] - position[i];
+    float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+    float moveDistance = SPEED * deltaTime;
 
-                    // Random movement if no valid pathfinding move
-                    if (!foundValidMove) {
-                        newTarget = targetPosition;
-                        if (rand() % 2 == 0) {
-                            newTarget.y -= TILE_SIZE;
-                            if (canMoveTo(newTarget)) {
-                                
-                                foundValidMove = true;
-                            }
-                            else {
-                                newTarget.y = targetPosition.y + TILE_SIZE;
-                                if (canMoveTo(newTarget)) {
-                                    
-                                    foundValidMove = true;
-                                }
-                            }
-                        }
-                        else {
-                            newTarget.y += TILE_SIZE;
-                            if (canMoveTo(newTarget)) {
-                                
-                                foundValidMove = true;
-                            }
-                            else {
-                                newTarget.y = targetPosition.y - TILE_SIZE;
-                                if (canMoveTo(newTarget)) {
-                                   
-                                    foundValidMove = true;
-                                }
-                            }
-                        }
-                    }
-                }
+    if (distance < 0.1f || moveDistance >= distance) {
+        position[i] = target[i];
+        moving[i] = 0;
 
-                if (foundValidMove && newTarget != targetPosition) {
-                    targetPosition = newTarget;
-                    isMoving = true;
-                }
-            }
+        // A ghost turns solid again once it reaches an open tunnel
+        if (ghost[i] && map->getTileAt(target[i].x, target[i].y) == TileType::Empty) {
+            ghost[i] = 0;
         }
+    }
+    else {
+        position[i] += direction / distance * moveDistance;
+    }
+}
 
-        // Movement logic
-        if (isMoving) {
-            sf::Vector2f direction = targetPosition - currentPosition;
-            float distance = std::sqrt(direction.x * direction.x + direction.y * direction.y);
-
-            if (distance < 0.1f) {
-                sprite.setPosition(targetPosition);
-                isMoving = false;
+void PookaStore::animate(size_t i, float deltaTime) {
+    animationRow[i] = ghost[i] ? 1 : 0;
+    hitboxEnabled[i] = ghost[i] ? 0 : 1;
 
-                if (status == 1) {
-                    int tileType = map->getTileAt(targetPosition.x, targetPosition.y);
-                    if (tileType == 0) {
-                        status = 0;
-                    }
-                }
-            }
-            else {
-                direction.x /= distance;
-                direction.y /= distance;
-                float moveDistance = speed * deltaTime;
-                if (moveDistance >= distance) {
-                    sprite.setPosition(targetPosition);
-                    isMoving = false;
-
-                    if (status == 1) {
-                        int tileType = map->getTileAt(targetPosition.x, targetPosition.y);
-                        if (tileType == 0) {
-                            status = 0;
-                        }
-                    }
-                }
-                else {
-                    currentPosition.x += direction.x * moveDistance;
-                    currentPosition.y += direction.y * moveDistance;
-                    sprite.setPosition(currentPosition);
-                }
-            }
+    animationTime[i] += deltaTime;
+    if (animationTime[i] >= ANIMATION_SWITCH_TIME) {
+        animationTime[i] -= ANIMATION_SWITCH_TIME;
+        animationFrame[i]++;
+        if (animationFrame[i] >= ANIMATION_FRAMES) {
+            animationFrame[i] = 0;
         }
-        if (isMoving) {
-            if (status == 1) {
-                animation->Update(1, deltaTime, sprite);
-                hitbox.setSize(sf::Vector2f(0, 0));
-            }
-            else {
-                animation->Update(0, deltaTime, sprite);
-                hitbox.setSize(sf::Vector2f(10.f, 10.f));
-                sf::Vector2f spriteCenter = sprite.getPosition() + sf::Vector2f(size.x / 2.f, size.y / 2.f);
-                hitbox.setOrigin(hitbox.getSize() / 2.f);
-                hitbox.setPosition(spriteCenter);
-            }
-        }
-
-        hitbox.setPosition(sprite.getPosition());
     }
 }
 
-bool Pooka::canMoveTo(sf::Vector2f position) {
+bool PookaStore::canMoveTo(size_t i, sf::Vector2f pos) const {
     if (map == nullptr) return false;
 
     sf::Vector2i mapSize = map->getMapSize();
-    if (position.x < 0 || position.x >= mapSize.x ||
-        position.y < 0 || position.y >= mapSize.y) {
+    if (pos.x < 0 || pos.x >= mapSize.x ||
+        pos.y < 0 || pos.y >= mapSize.y) {
         return false;
     }
-    int tileType = map->getTileAt(position.x, position.y);
+    TileType tileType = map->getTileAt(pos.x, pos.y);
 
-    if (status == 0)
-        return (tileType == 0);
-    if (status == 1)
-        return (tileType == 0 || tileType == 2 || tileType == 3 || tileType == 4);
-
-    return false;
+    if (!ghost[i])
+        return (tileType == TileType::Empty);
+    return (tileType == TileType::Empty || tileType == TileType::Dirt1 || tileType == TileType::Dirt2 || tileType == TileType::Dirt3);
 }
 
-void Pooka::AttachHarpoon() {
-    if (!harpoonStuck) {
-        harpoonStuck = true;
-        std::cout << "Harpoon attached to Pooka" << std::endl;
+void PookaStore::AttachHarpoon(size_t i) {
+    if (!harpoonStuck[i]) {
+        harpoonStuck[i] = 1;
+        LOG_DEBUG("Harpoon attached to Pooka");
     }
 }
 
-void Pooka::DetachHarpoon() {
-    if (harpoonStuck) {
-        harpoonStuck = false;
+void PookaStore::DetachHarpoon(size_t i) {
+    if (harpoonStuck[i]) {
+        harpoonStuck[i] = 0;
         if (player != nullptr) {
             player->DetachHarpoon();
         }
-        std::cout << "Harpoon detached from Pooka" << std::endl;
+        LOG_DEBUG("Harpoon detached from Pooka");
     }
 }
 
-
-void Pooka::Inflate() {
-    if (harpoonStuck) { 
-        if (pumpState < MAX_PUMP_STATE) { 
-            pumpState++;
-            std::cout << "Pooka inflated to state: " << pumpState << std::endl;
-            updateInflationSprite(); // 
-
-            if (pumpState >= MAX_PUMP_STATE) {
-                // Pooka is fully pumped, maybe it explodes or is defeated
-                // Trigger death animation, score points, etc.
-
-                isAlive = false;
-                std::cout << "Pooka fully inflated!" << std::endl;
-                DetachHarpoon();
-                // dont detach harpoon here, if you a death animation/effect
-            }
+void PookaStore::Inflate(size_t i) {
+    if (harpoonStuck[i] && pumpState[i] < MAX_PUMP_STATE) {
+        pumpState[i]++;
+        LOG_DEBUG("Pooka inflated to state: " << static_cast<int>(pumpState[i]));
+        updateInflationSprite(i);
+
+        if (pumpState[i] >= MAX_PUMP_STATE) {
+            // Fully pumped: the Pooka pops
+            alive[i] = 0;
+            LOG_DEBUG("Pooka fully inflated!");
+            DetachHarpoon(i);
         }
     }
 }
 
-void Pooka::updateInflationSprite() {
-    switch (pumpState) {
-    case 0:
-        sprite.setScale(sf::Vector2f(1.0f, 1.0f));
-        // Restore normal hitbox size
-        break;
-    case 1:
-        sprite.setScale(sf::Vector2f(1.2f, 1.2f));
-        // Disable hitbox
-
-        break;
-    case 2:
-        sprite.setScale(sf::Vector2f(1.4f, 1.4f));
-        // Disable hitbox
-     
-        break;
-    case 3:
-        sprite.setScale(sf::Vector2f(1.6f, 1.6f));
-        // Disable hitbox
-   
-        break;
-    case 4:
-        sprite.setScale(sf::Vector2f(1.8f, 1.6f));
-        // Disable hitbox
-        break;
-}
-    sf::Vector2f newScale = sprite.getScale();
-
-    // Update hitbox origin to match sprite position
-    hitbox.setSize(sf::Vector2f(size.x - 6, size.y - 6));
-    hitbox.setOrigin(sf::Vector2f(hitbox.getSize().x / 2.0f, hitbox.getSize().y / 2.0f));
-
-    std::cout << "Pooka sprite updated for pump state: " << pumpState << std::endl;
+void PookaStore::updateInflationSprite(size_t i) {
+    static constexpr sf::Vector2f PUMP_SCALES[MAX_PUMP_STATE + 1] = {
+        { 1.0f, 1.0f }, { 1.2f, 1.2f }, { 1.4f, 1.4f }, { 1.6f, 1.6f }, { 1.8f, 1.6f }
+    };
+    scale[i] = PUMP_SCALES[pumpState[i]];
+    // Restore the normal hitbox in case it was dropped while ghosting
+    hitboxEnabled[i] = 1;
 }
 
+void PookaStore::Draw(sf::RenderWindow& window) {
+    const size_t count = Size();
+    const float alpha = GameSprite::GetInterpolationAlpha();
+
+    // All Pooka sprites go out in a single draw call
+    if (spriteSheet.texture) {
+        spriteVertices.clear();
+        const sf::Vector2f corners[4] = { { 0, 0 }, { SPRITE_SIZE, 0 }, { 0, SPRITE_SIZE }, { SPRITE_SIZE, SPRITE_SIZE } };
+        const sf::Vector2f origin(SPRITE_SIZE / 2.0f, SPRITE_SIZE / 2.0f);
+        for (size_t i = 0; i < count; i++) {
+            if (!alive[i] || health[i] <= 0) continue;
+
+            sf::Vector2f drawPosition = previousPosition[i] + (position[i] - previousPosition[i]) * alpha;
+            sf::Vector2f uv(static_cast<float>(animationFrame[i] * SPRITE_SIZE), static_cast<float>(animationRow[i] * SPRITE_SIZE));
+            sf::Vertex quad[4];
+            for (int c = 0; c < 4; c++) {
+                sf::Vector2f local = corners[c] - origin;
+                quad[c].position = drawPosition + sf::Vector2f(local.x * scale[i].x, local.y * scale[i].y);
+                quad[c].texCoords = spriteSheet.map(uv + corners[c]);
+                quad[c].color = sf::Color::White;
+            }
+            spriteVertices.append(quad[0]);
+            spriteVertices.append(quad[1]);
+            spriteVertices.append(quad[2]);
+            spriteVertices.append(quad[2]);
+            spriteVertices.append(quad[1]);
+            spriteVertices.append(quad[3]);
+        }
+        sf::RenderStates states;
+        states.texture = spriteSheet.texture.get();
+        window.draw(spriteVertices, states);
+    }
 
-bool Pooka::isHarpoonAttached() const {
-    return harpoonStuck;
-}
-
-void Pooka::setPosition(sf::Vector2f pos) {
-    // Snap to grid for tile-based movement
-    pos.x = ((int)pos.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-    pos.y = ((int)pos.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-
-    targetPosition = pos;
-    sprite.setPosition(pos);
-    hitbox.setPosition(pos);
-    isMoving = false;
-}
-
-void Pooka::Draw(sf::RenderWindow& window) {
-    if (isAlive && health > 0) {
-        window.draw(sprite);
-        window.draw(hitbox);
+    for (size_t i = 0; i < count; i++) {
+        if (!alive[i] || health[i] <= 0) continue;
+        float side = hitboxEnabled[i] ? 10.0f : 0.0f;
+        hitboxShape.setSize({ side, side });
+        hitboxShape.setOrigin({ 5.0f, 5.0f });
+        hitboxShape.setPosition(position[i]);
+        window.draw(hitboxShape);
     }
-}
\ No newline at end of file
+}
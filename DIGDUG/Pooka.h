@@ -1,66 +1,108 @@
 #pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
 #include "Entity.h"
-#include <SFML/Audio.hpp>
+#include "SlotMap.h"
+#include "TextureAtlas.h"
 
 class Player;
 class Map;
+class Random;
+class FlowField;
 
-class Pooka : public Entity {
+// Every Pooka in the stage, stored as parallel arrays and updated in batches.
+// Index i in each vector describes the same Pooka. Removal swaps the last Pooka
+// into the hole, so indices are only stable within a tick; hold an EntityID
+// (resolved through the slot map) to refer to a Pooka across ticks.
+class PookaStore {
 private:
-    Player* player;
+    static constexpr int SPRITE_SIZE = 16;
+    static constexpr int TILE_SIZE = 16;
+    static constexpr int MAX_HEALTH = 4;
+    static constexpr float SPEED = 15.0f;
+    static constexpr int MAX_PUMP_STATE = 4;
+    static constexpr float PUMP_DURATION = 1.0f;
+    static constexpr float PUMP_COOLDOWN = 0.1f;
+    static constexpr unsigned ANIMATION_FRAMES = 2;
+    static constexpr float ANIMATION_SWITCH_TIME = 0.25f;
+
     Map* map;
-    int health;
-    float speed;
-    int status; // 0 = default, 1 = ghost form
-
-    sf::Sprite sprite;
-    sf::Texture texture;
-
-    sf::Vector2f initialPos;
-    float movementTimer = 0.0f;
-    float movementDelay = 1.0f;
-    float stuckTimer = 0.0f;
-    float ghostModeDelay = 2.0f + static_cast<float>(rand()) / RAND_MAX * 5.0f;
-
-    bool harpoonStuck = false;
-    sf::SoundBuffer pumpBuffer;
-    sf::Sound pumpSound;
-    int pumpState = 0; // 0 = normal, 1 = first pump, 2 = second pump, 3 = third pump, 4 = DEAD AF
-    float pumpTimer = 0.0f;
-    const int MAX_PUMP_STATE = 4;
-    const float PUMP_DURATION = 1.0f;
-    float pumpCooldownTimer = 0.0f;
-    const float PUMP_COOLDOWN = 0.1f;
+    Player* player;
+    Random* rng;
+    TextureRegion spriteSheet;   // From TextureAtlas; no texture in headless mode
 
+    // Identity and liveness
+    SlotMap slots;
+    std::vector<uint8_t> alive;
+    std::vector<uint8_t> health;
 
-private:
-    bool canMoveTo(sf::Vector2f position);
+    // Movement
+    std::vector<sf::Vector2f> position;
+    std::vector<sf::Vector2f> previousPosition;   // For render interpolation
+    std::vector<sf::Vector2f> target;
+    std::vector<uint8_t> moving;
+    std::vector<uint8_t> ghost;                   // Drifting through dirt towards the player
+
+    // AI timers
+    std::vector<float> movementTimer;
+    std::vector<float> movementDelay;
+    std::vector<float> stuckTimer;
+    std::vector<float> ghostModeDelay;
+
+    // Harpoon / pump state
+    std::vector<uint8_t> harpoonStuck;
+    std::vector<uint8_t> pumpState;   // 0 = normal, 1..3 = inflating, 4 = popped
+    std::vector<float> pumpTimer;
+    std::vector<float> pumpCooldownTimer;
+
+    // Presentation
+    std::vector<sf::Vector2f> scale;
+    std::vector<uint8_t> animationRow;
+    std::vector<uint8_t> animationFrame;
+    std::vector<float> animationTime;
+    std::vector<uint8_t> hitboxEnabled;   // Ghosts in motion have no hitbox
+
+    std::vector<uint32_t> activeScratch;
+    sf::VertexArray spriteVertices;
+    sf::RectangleShape hitboxShape;
+
+    bool canAct(size_t i) const;
+    bool canMoveTo(size_t i, sf::Vector2f pos) const;
+    void chooseTarget(size_t i, sf::Vector2f playerPosition, const FlowField& flowField);
+    void moveTowardsTarget(size_t i, float deltaTime);
+    void animate(size_t i, float deltaTime);
+    void updateInflationSprite(size_t i);
+    void removeAt(size_t i);
 
 public:
-    Pooka(Map* gameMap, Player* player);
-    void Initialise() override;
-    void Load() override;
-    void Update(float deltaTime, sf::Vector2f playerPosition) override;
-    void Draw(sf::RenderWindow& window) override;
-
-    void AttachHarpoon() override;
-    void DetachHarpoon() override;
-    void Inflate() override;
-    bool isHarpoonAttached() const override;
-    void updateInflationSprite() override;
-    void setPosition(sf::Vector2f pos) override;
-    bool getInflationStatus() override {
-        if (pumpState > 0) {
-            return true;
-        }
-        else {
-            return false;
-        }
-    }
-
-    sf::FloatRect getBounds() const {
-        return hitbox.getGlobalBounds();
-    }
-
-    int getHealth() const { return health; }
-};
\ No newline at end of file
+    PookaStore(Map* gameMap, Player* player, Random* random);
+
+    void Load();
+    EntityID Spawn(sf::Vector2f pos);
+    // `flowField` must be rooted at the player and current for this tick
+    void Update(float deltaTime, sf::Vector2f playerPosition, const FlowField& flowField);
+    void Draw(sf::RenderWindow& window);
+
+    // Drops dead Pookas in O(1) each. Returns how many were removed.
+    size_t RemoveDead();
+    void Clear();
+    void Reserve(size_t count);
+
+    size_t Size() const { return slots.Size(); }
+    // Index of the Pooka with this id, or -1 if it has been removed
+    int Find(EntityID id) const { return slots.IndexOf(id); }
+
+    EntityID GetID(size_t i) const { return slots.IdAt(i); }
+    bool IsAlive(size_t i) const { return alive[i] != 0; }
+    void Kill(size_t i) { alive[i] = 0; }
+    sf::Vector2f GetPosition(size_t i) const { return position[i]; }
+    sf::FloatRect GetBounds(size_t i) const;
+    bool IsInflated(size_t i) const { return pumpState[i] > 0; }
+
+    void AttachHarpoon(size_t i);
+    void DetachHarpoon(size_t i);
+    void Inflate(size_t i);
+    bool IsHarpoonAttached(size_t i) const { return harpoonStuck[i] != 0; }
+};
@@ -0,0 +1,134 @@
+#include "Profiler.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+std::atomic<bool> Profiler::enabled{ false };
+thread_local uint32_t ProfileScope::currentDepth = 0;
+
+namespace {
+    // One slot per frame; the slot for currentFrame is being written, the rest are complete
+    std::array<Profiler::Frame, Profiler::FRAME_HISTORY> frames;
+    std::atomic<uint64_t> currentFrame{ 0 };
+    std::atomic<uint64_t> completedFrames{ 0 };
+    std::atomic<uint32_t> zoneCursor{ 0 };   // Next free zone in the current slot
+
+    std::atomic<uint32_t> nextThreadId{ 1 };
+    thread_local uint32_t threadId = 0;
+
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    Profiler::Frame& slotFor(uint64_t frame) {
+        return frames[frame % Profiler::FRAME_HISTORY];
+    }
+
+    uint32_t currentThreadId() {
+        if (threadId == 0) {
+            threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+        }
+        return threadId;
+    }
+
+    void resetSlot(uint64_t frame) {
+        Profiler::Frame& slot = slotFor(frame);
+        slot.index = frame;
+        slot.startNs = Profiler::Now();
+        slot.endNs = slot.startNs;
+        slot.zoneCount = 0;
+        slot.droppedZones = 0;
+        zoneCursor.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::SetEnabled(bool enable) {
+    if (enable && !IsEnabled()) {
+        // Start a fresh frame so zones recorded before the next BeginFrame are not lost
+        resetSlot(currentFrame.load(std::memory_order_relaxed));
+    }
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+uint64_t Profiler::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+void Profiler::BeginFrame() {
+    if (IsEnabled()) {
+        resetSlot(currentFrame.load(std::memory_order_relaxed));
+    }
+}
+
+void Profiler::EndFrame() {
+    if (!IsEnabled()) {
+        return;
+    }
+    uint64_t frame = currentFrame.load(std::memory_order_relaxed);
+    Frame& slot = slotFor(frame);
+    uint32_t claimed = zoneCursor.load(std::memory_order_acquire);
+    slot.zoneCount = std::min<uint32_t>(claimed, MAX_ZONES_PER_FRAME);
+    slot.droppedZones = claimed - slot.zoneCount;
+    slot.endNs = Now();
+    completedFrames.fetch_add(1, std::memory_order_relaxed);
+    currentFrame.store(frame + 1, std::memory_order_release);
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth) {
+    uint32_t index = zoneCursor.fetch_add(1, std::memory_order_acq_rel);
+    if (index >= MAX_ZONES_PER_FRAME) {
+        return;   // Counted as dropped when the frame ends
+    }
+    Frame& slot = slotFor(currentFrame.load(std::memory_order_acquire));
+    slot.zones[index] = { name, startNs, endNs, currentThreadId(), depth };
+}
+
+size_t Profiler::GetFrameCount() {
+    // The slot being recorded is not complete, so one less than the ring holds
+    return static_cast<size_t>(std::min<uint64_t>(completedFrames.load(std::memory_order_relaxed), FRAME_HISTORY - 1));
+}
+
+const Profiler::Frame* Profiler::GetFrame(size_t framesAgo) {
+    if (framesAgo >= GetFrameCount()) {
+        return nullptr;
+    }
+    uint64_t frame = currentFrame.load(std::memory_order_acquire);
+    return &slotFor(frame - 1 - framesAgo);
+}
+
+bool Profiler::ExportChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        LOG_ERROR("Failed to open profiler trace file: " << filename);
+        return false;
+    }
+
+    // Trace-event format: "X" events are complete spans with a start and a duration in µs
+    auto micros = [](uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+    size_t frameCount = GetFrameCount();
+    size_t zoneCount = 0;
+    for (size_t i = frameCount; i-- > 0;) {
+        const Frame& frame = *GetFrame(i);
+        file << ",\n{\"name\":\"Frame " << frame.index << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0"
+            << ",\"ts\":" << micros(frame.startNs) << ",\"dur\":" << micros(frame.endNs - frame.startNs);
+        if (frame.droppedZones > 0) {
+            file << ",\"args\":{\"droppedZones\":" << frame.droppedZones << "}";
+        }
+        file << "}";
+        for (uint32_t z = 0; z < frame.zoneCount; z++) {
+            const Zone& zone = frame.zones[z];
+            file << ",\n{\"name\":\"" << zone.name << "\",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.threadId
+                << ",\"ts\":" << micros(zone.startNs) << ",\"dur\":" << micros(zone.endNs - zone.startNs) << "}";
+        }
+        zoneCount += frame.zoneCount;
+    }
+    file << "\n]}\n";
+    if (!file) {
+        LOG_ERROR("Failed to write profiler trace file: " << filename);
+        return false;
+    }
+    LOG_INFO("Wrote " << frameCount << " frames (" << zoneCount << " zones) to " << filename);
+    return true;
+}
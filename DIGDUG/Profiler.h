@@ -0,0 +1,99 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Zones are compiled out entirely when PROFILER_ENABLED is 0, e.g. /DPROFILER_ENABLED=0
+// for a shipping build. When compiled in they cost one branch until enabled at runtime.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+// Frame profiler. PROFILE_SCOPE records a named, timed zone into the current frame's
+// slot of a fixed ring of frames; BeginFrame/EndFrame advance the ring. Recording
+// never locks or allocates: each zone claims its slot with one atomic increment and
+// zones past the per-frame capacity are dropped and counted. Completed frames can be
+// read back for the overlay or written out as Chrome trace-event JSON
+// (chrome://tracing, Perfetto).
+class Profiler
+{
+public:
+    static const int MAX_ZONES_PER_FRAME = 256;
+    static const int FRAME_HISTORY = 128;
+
+    struct Zone {
+        const char* name;   // Must outlive the profiler; PROFILE_SCOPE passes literals
+        uint64_t startNs;
+        uint64_t endNs;
+        uint32_t threadId;
+        uint32_t depth;     // Nesting level on its thread, 0 = outermost
+    };
+
+    struct Frame {
+        uint64_t index = 0;
+        uint64_t startNs = 0;
+        uint64_t endNs = 0;
+        uint32_t zoneCount = 0;
+        uint32_t droppedZones = 0;
+        std::array<Zone, MAX_ZONES_PER_FRAME> zones;
+    };
+
+    static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool enable);
+
+    static void BeginFrame();
+    static void EndFrame();
+
+    // Nanoseconds since the profiler was first used
+    static uint64_t Now();
+    static void Record(const char* name, uint64_t startNs, uint64_t endNs, uint32_t depth);
+
+    // Number of completed frames still held in the ring
+    static size_t GetFrameCount();
+    // Completed frame, 0 = most recent. Returns null once it has been overwritten.
+    static const Frame* GetFrame(size_t framesAgo);
+
+    // Writes every completed frame in the ring; returns false if the file can't be written
+    static bool ExportChromeTrace(const std::string& filename);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+// Times the enclosing scope as one zone
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char* name) : name(name) {
+        if (Profiler::IsEnabled()) {
+            depth = currentDepth++;
+            startNs = Profiler::Now();
+            active = true;
+        }
+    }
+    ~ProfileScope() {
+        if (active) {
+            Profiler::Record(name, startNs, Profiler::Now(), depth);
+            currentDepth--;
+        }
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    uint64_t startNs = 0;
+    uint32_t depth = 0;
+    bool active = false;
+
+    static thread_local uint32_t currentDepth;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) do {} while (0)
+#endif
@@ -0,0 +1,108 @@
+#include "ProfilerOverlay.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    const float GRAPH_HEIGHT = 30.0f;
+    const float GRAPH_BUDGET_MS = 1000.0f / 60.0f;   // A full-height bar is one 60 Hz frame
+}
+
+ProfilerOverlay::ProfilerOverlay(const sf::Font& font)
+    : text(font, "", 8), graph(sf::PrimitiveType::Triangles) {
+    text.setFillColor(sf::Color::White);
+    text.setPosition(sf::Vector2f(2, GRAPH_HEIGHT + 2));
+    background.setFillColor(sf::Color(0, 0, 0, 180));
+    background.setPosition(sf::Vector2f(0, 0));
+}
+
+void ProfilerOverlay::Update() {
+    if (!visible) {
+        return;
+    }
+
+    // Frame-time bars, oldest on the left; red once over the 60 Hz budget
+    size_t frameCount = Profiler::GetFrameCount();
+    graph.resize(frameCount * 6);
+    const float barWidth = 224.0f / Profiler::FRAME_HISTORY;
+    for (size_t i = 0; i < frameCount; i++) {
+        const Profiler::Frame& frame = *Profiler::GetFrame(frameCount - 1 - i);
+        float ms = (frame.endNs - frame.startNs) / 1e6f;
+        float height = std::min(ms / GRAPH_BUDGET_MS, 1.0f) * GRAPH_HEIGHT;
+        sf::Color color = ms > GRAPH_BUDGET_MS ? sf::Color::Red : sf::Color::Green;
+        float left = i * barWidth;
+        float right = left + barWidth;
+        float top = GRAPH_HEIGHT - height;
+        sf::Vertex* quad = &graph[i * 6];
+        quad[0].position = { left, top };
+        quad[1].position = { right, top };
+        quad[2].position = { left, GRAPH_HEIGHT };
+        quad[3].position = { left, GRAPH_HEIGHT };
+        quad[4].position = { right, top };
+        quad[5].position = { right, GRAPH_HEIGHT };
+        for (int v = 0; v < 6; v++) {
+            quad[v].color = color;
+        }
+    }
+
+    if (++framesSinceRefresh < REFRESH_INTERVAL) {
+        return;
+    }
+    framesSinceRefresh = 0;
+
+    // Aggregate zones by name over the sample window
+    stats.clear();
+    size_t samples = std::min<size_t>(frameCount, SAMPLE_FRAMES);
+    uint64_t frameTotalNs = 0;
+    uint64_t frameMaxNs = 0;
+    uint32_t dropped = 0;
+    for (size_t i = 0; i < samples; i++) {
+        const Profiler::Frame& frame = *Profiler::GetFrame(i);
+        uint64_t frameNs = frame.endNs - frame.startNs;
+        frameTotalNs += frameNs;
+        frameMaxNs = std::max(frameMaxNs, frameNs);
+        dropped += frame.droppedZones;
+        for (uint32_t z = 0; z < frame.zoneCount; z++) {
+            const Profiler::Zone& zone = frame.zones[z];
+            uint64_t ns = zone.endNs - zone.startNs;
+            auto it = std::find_if(stats.begin(), stats.end(), [&](const ZoneStats& s) { return s.name == zone.name; });
+            if (it == stats.end()) {
+                stats.push_back({ zone.name, zone.depth, ns, ns, 1 });
+            }
+            else {
+                it->totalNs += ns;
+                it->maxNs = std::max(it->maxNs, ns);
+                it->depth = std::min(it->depth, zone.depth);
+                it->calls++;
+            }
+        }
+    }
+    std::sort(stats.begin(), stats.end(), [](const ZoneStats& a, const ZoneStats& b) { return a.totalNs > b.totalNs; });
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    if (samples > 0) {
+        out << "frame " << (frameTotalNs / 1e6 / samples) << " ms  max " << (frameMaxNs / 1e6) << " ms\n";
+    }
+    out << "zone (avg ms/frame, max ms)\n";
+    for (size_t i = 0; i < stats.size() && i < MAX_ROWS; i++) {
+        const ZoneStats& s = stats[i];
+        out << std::string(s.depth * 2, ' ') << s.name << "  " << (s.totalNs / 1e6 / samples) << "  " << (s.maxNs / 1e6) << '\n';
+    }
+    if (dropped > 0) {
+        out << dropped << " zones dropped\n";
+    }
+    text.setString(out.str());
+    sf::FloatRect bounds = text.getGlobalBounds();
+    background.setSize(sf::Vector2f(224.0f, bounds.position.y + bounds.size.y + 4));
+}
+
+void ProfilerOverlay::Draw(sf::RenderWindow& window) {
+    if (!visible) {
+        return;
+    }
+    window.draw(background);
+    window.draw(graph);
+    window.draw(text);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string_view>
+#include <vector>
+
+// On-screen view of the Profiler ring: a frame-time graph plus per-zone averages
+// over the recent frames. Part of the windowed frontend only.
+class ProfilerOverlay
+{
+public:
+    explicit ProfilerOverlay(const sf::Font& font);
+
+    void SetVisible(bool show) { visible = show; }
+    bool IsVisible() const { return visible; }
+
+    // Call once per frame after Profiler::EndFrame
+    void Update();
+    void Draw(sf::RenderWindow& window);
+
+private:
+    struct ZoneStats {
+        std::string_view name;
+        uint32_t depth;
+        uint64_t totalNs;
+        uint64_t maxNs;
+        uint32_t calls;
+    };
+
+    static const int SAMPLE_FRAMES = 60;      // Frames averaged for the zone table
+    static const int REFRESH_INTERVAL = 15;   // Frames between text updates, keeps it readable
+    static const int MAX_ROWS = 12;
+
+    bool visible = false;
+    int framesSinceRefresh = REFRESH_INTERVAL;
+    std::vector<ZoneStats> stats;
+    sf::Text text;
+    sf::RectangleShape background;
+    sf::VertexArray graph;   // One bar per frame in the ring
+};
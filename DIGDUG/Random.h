@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+// Small, fast, seedable PRNG (xoshiro128**) so identical seeds replay identically.
+// Each EnemyManager owns one and reseeds it per stage; nothing shares libc rand() state.
+class Random
+{
+public:
+	explicit Random(uint64_t seed = 1) { Seed(seed); }
+
+	void Seed(uint64_t seed)
+	{
+		// Expand the seed with splitmix64 so nearby seeds give unrelated streams
+		for (uint32_t& word : state) {
+			seed += 0x9E3779B97F4A7C15ull;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			word = static_cast<uint32_t>((z ^ (z >> 31)) >> 32);
+		}
+	}
+
+	uint32_t Next()
+	{
+		const uint32_t result = rotl(state[1] * 5, 7) * 9;
+		const uint32_t t = state[1] << 9;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotl(state[3], 11);
+		return result;
+	}
+
+	// Uniform in [0, 1)
+	float NextFloat() { return (Next() >> 8) * (1.0f / 16777216.0f); }
+	float Range(float min, float max) { return min + NextFloat() * (max - min); }
+	bool NextBool() { return (Next() >> 31) != 0; }
+
+	// Derive an independent seed for a sub-stream, e.g. one per stage
+	static uint64_t Combine(uint64_t seed, uint64_t salt) { return seed ^ (salt * 0x9E3779B97F4A7C15ull + 0x632BE59BD9B4E019ull); }
+
+private:
+	static uint32_t rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+	uint32_t state[4];
+};
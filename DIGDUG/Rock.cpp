@@ -1,8 +1,9 @@
 #include "Rock.h"
+#include "Log.h"
 #include "EnemyManager.h"
 #include "Player.h"
 #include "Map.h"
-#include <iostream>
+#include "TextureAtlas.h"
 #include <cmath>
 
 Rock::Rock(Map* gameMap, EnemyManager* em, Player* p, sf::Vector2f pos, sf::Vector2i tileTypeSourceGrid)
@@ -11,13 +12,32 @@ Rock::Rock(Map* gameMap, EnemyManager* em, Player* p, sf::Vector2f pos, sf::Vect
     initialTileTypeSource(tileTypeSourceGrid),
     isFalling(false), fallTimer(0.0f), hasFallen(false),
     destroyAnimationStarted(false), destroyAnimationComplete(false),
-    tileSprite(tileTexture), rockSprite(rockTexture), tileTypeTextureIndex(-1),
+    tileTypeTextureIndex(-1),
     shakeTimer(0.0f), isShaking(false), destroyTimer(0.0f),
     markedForDeletion(false)
 {
     setPosition(pos);
 }
 
+void Rock::Reset(sf::Vector2f pos, int textureIndex) {
+    isAlive = true;
+    isMoving = false;
+    isFalling = false;
+    fallTimer = 0.0f;
+    hasFallen = false;
+    isShaking = false;
+    shakeTimer = 0.0f;
+    destroyAnimationStarted = false;
+    destroyAnimationComplete = false;
+    destroyTimer = 0.0f;
+    markedForDeletion = false;
+    initialTileTypeSource = sf::Vector2i(0, 0);
+    tileTypeTextureIndex = textureIndex;
+    tileSprite.setColor(sf::Color::White);
+    rockSprite.setColor(sf::Color::White);
+    setPosition(pos);
+}
+
 void Rock::Initialise() {
     Entity::Initialise();
     hitbox.setSize(sf::Vector2f(TILE_SIZE, TILE_SIZE));
@@ -26,44 +46,49 @@ void Rock::Initialise() {
 }
 
 void Rock::Load() {
-    if (!tileTexture.loadFromFile("Assets/Map/tilesheet.png")) {
-        std::cout << "Failed to load rock tilesheet texture" << '\n';
-        return;
+    // Same tilesheet the Map draws from, so this is a cache hit. Pooled rocks keep theirs.
+    if (!tileSheet.texture) {
+        tileSheet = TextureAtlas::GetRegion("Assets/Map/tilesheet.png");
     }
-    if (!rockTexture.loadFromFile("Assets/Map/rock.png")) {
-        std::cout << "Failed to load rock overlay texture" << '\n';
-        return;
+    if (!rockImage.texture) {
+        rockImage = TextureAtlas::GetRegion("Assets/Map/rock.png");
+    }
+    if (tileSheet.texture && rockImage.texture) {
+        tileSprite.setTexture(*tileSheet.texture);
+        rockSprite.setTexture(*rockImage.texture);
     }
-    tileSprite.setTexture(tileTexture);
     tileSprite.setOrigin(sf::Vector2f(TILE_SIZE / 2.0f, TILE_SIZE / 2.0f));
     tileSprite.setScale(sf::Vector2f(1, 1));
     if (tileTypeTextureIndex != -1) {
-        tileSprite.setTextureRect(sf::IntRect({ tileTypeTextureIndex * TILE_SIZE, 0 }, { TILE_SIZE, TILE_SIZE }));
-        std::cout << "Rock tile texture set to index: " << tileTypeTextureIndex << '\n';
+        tileSprite.setTextureRect(tileSheet.map(sf::IntRect({ tileTypeTextureIndex * TILE_SIZE, 0 }, { TILE_SIZE, TILE_SIZE })));
+        LOG_DEBUG("Rock tile texture set to index: " << tileTypeTextureIndex);
     }
     else {
-        tileSprite.setTextureRect(sf::IntRect({ 1 * TILE_SIZE, 0 }, { TILE_SIZE, TILE_SIZE }));
-        std::cout << "Rock using fallback tile texture (index 1)" << '\n';
+        tileSprite.setTextureRect(tileSheet.map(sf::IntRect({ 1 * TILE_SIZE, 0 }, { TILE_SIZE, TILE_SIZE })));
+        LOG_DEBUG("Rock using fallback tile texture (index 1)");
     }
-    rockSprite.setTexture(rockTexture);
     rockSprite.setOrigin(sf::Vector2f(TILE_SIZE / 2.0f, TILE_SIZE / 2.0f));
     rockSprite.setScale(sf::Vector2f(1, 1));
-    rockSprite.setTextureRect(sf::IntRect({ 0, 0 }, { TILE_SIZE, TILE_SIZE }));
+    rockSprite.setTextureRect(rockImage.map(sf::IntRect({ 0, 0 }, { TILE_SIZE, TILE_SIZE })));
     tileSprite.setPosition(getPosition());
     rockSprite.setPosition(getPosition());
-    std::cout << "Rock loaded successfully with layered rendering at position ("
-        << getPosition().x << ", " << getPosition().y << ")" << '\n';
+    tileSprite.storePreviousPosition();
+    rockSprite.storePreviousPosition();
+    LOG_DEBUG("Rock loaded successfully with layered rendering at position ("
+        << getPosition().x << ", " << getPosition().y << ")");
 }
 
 void Rock::Update(float deltaTime, sf::Vector2f playerPosition) {
+    tileSprite.storePreviousPosition();
+    rockSprite.storePreviousPosition();
     // Handle destruction animation first, regardless of alive status
     if (!isAlive && destroyAnimationStarted && !destroyAnimationComplete) {
         destroyTimer += deltaTime;
         if (destroyTimer >= DESTROY_ANIMATION_DURATION) {
             destroyAnimationComplete = true;
             markedForDeletion = true;
-            std::cout << "Rock marked for deletion after destruction animation completed at position ("
-                << getPosition().x << ", " << getPosition().y << ")" << std::endl;
+            LOG_DEBUG("Rock marked for deletion after destruction animation completed at position ("
+                << getPosition().x << ", " << getPosition().y << ")");
         }
     }
 
@@ -76,16 +101,16 @@ void Rock::Update(float deltaTime, sf::Vector2f playerPosition) {
     // Check the tile below the rock's bottom edge, not center
     float rockBottomY = currentRockCenter.y + TILE_SIZE / 2.0f;
     float checkYBelow = rockBottomY + 1.0f; // Check just below the rock's bottom edge
-    int tileBelowType = map->getTileAt(currentRockCenter.x, checkYBelow);
+    TileType tileBelowType = map->getTileAt(currentRockCenter.x, checkYBelow);
 
-    if (tileBelowType == 0 && !isFalling && !hasFallen) {
+    if (tileBelowType == TileType::Empty && !isFalling && !hasFallen) {
         if (!isShaking) {
             isShaking = true;
             fallTimer = 0.0f;
             int rockGridX = static_cast<int>(std::round(currentRockCenter.x / TILE_SIZE));
             int rockGridY = static_cast<int>(std::round(currentRockCenter.y / TILE_SIZE));
-            map->setTileAt(rockGridX * TILE_SIZE + TILE_SIZE / 2.0f, rockGridY * TILE_SIZE + TILE_SIZE / 2.0f, 0);
-            std::cout << "Tile underneath rock removed (shaking started)!" << std::endl;
+            map->setTileAt(rockGridX * TILE_SIZE + TILE_SIZE / 2.0f, rockGridY * TILE_SIZE + TILE_SIZE / 2.0f, TileType::Empty);
+            LOG_DEBUG("Tile underneath rock removed (shaking started)!");
         }
         fallTimer += deltaTime;
         float shakeOffset = std::sin(shakeTimer * SHAKE_SPEED_MULTIPLIER) * SHAKE_AMPLITUDE;
@@ -94,14 +119,14 @@ void Rock::Update(float deltaTime, sf::Vector2f playerPosition) {
         if (fallTimer >= FALL_DELAY) {
             isFalling = true;
             isShaking = false;
-            std::cout << "Rock started falling!" << std::endl;
+            LOG_DEBUG("Rock started falling!");
         }
     }
-    else if (tileBelowType > 0) { // Changed condition to check for solid tiles (> 0)
+    else if (Map::isSolidTile(tileBelowType)) {
         if (isFalling) {
             isFalling = false;
             hasFallen = true;
-            std::cout << "Rock hit solid ground!" << std::endl;
+            LOG_DEBUG("Rock hit solid ground!");
             // Mark as dead and start destroy animation immediately
             isAlive = false;
             startDestroyAnimation();
@@ -142,9 +167,9 @@ void Rock::updateFalling(float deltaTime) {
 
     // Check if the rock's bottom edge will hit a solid tile
     float rockBottomY = nextPosCandidate.y + TILE_SIZE / 2.0f;
-    int tileBelowType = map->getTileAt(nextPosCandidate.x, rockBottomY);
+    TileType tileBelowType = map->getTileAt(nextPosCandidate.x, rockBottomY);
 
-    if (tileBelowType == 0 || tileBelowType == -1) {
+    if (tileBelowType == TileType::Empty || tileBelowType == TileType::OutOfBounds) {
         // No solid tile below, continue falling
         setPosition(nextPosCandidate);
     }
@@ -158,7 +183,7 @@ void Rock::updateFalling(float deltaTime) {
         isFalling = false;
         hasFallen = true;
         isAlive = false; // Mark as dead when it hits the ground
-        std::cout << "Rock landed with bottom on top of solid tile at y=" << snappedRockCenterY << ". Tile type: " << tileBelowType << std::endl;
+        LOG_DEBUG("Rock landed with bottom on top of solid tile at y=" << snappedRockCenterY << ". Tile type: " << static_cast<int>(tileBelowType));
         startDestroyAnimation();
     }
 }
@@ -174,7 +199,7 @@ void Rock::checkAndSquashEntities() {
     if (player && player->isActive()) {
         sf::FloatRect playerBounds = player->getBounds();
         if (rockBounds.findIntersection(playerBounds)) {
-            std::cout << "Rock squashed player!" << std::endl;
+            LOG_INFO("Rock squashed player!");
             player->setHealth(0);
             if (player->getLives() > 0) {
                 player->setLives(player->getLives() - 1);
@@ -183,16 +208,12 @@ void Rock::checkAndSquashEntities() {
         }
     }
     if (enemyManager) {
-        const auto& enemies = enemyManager->GetEnemies();
-        for (auto& enemy : enemies) {
-            if (enemy && enemy->isActive()) {
-                sf::FloatRect enemyBounds = enemy->getBounds();
-                if (rockBounds.findIntersection(enemyBounds)) {
-                    std::cout << "Rock squashed an enemy!" << std::endl;
-                    enemy->setActive(false);
-                    hasSquashedSomething = true;
-                }
-            }
+        std::vector<EntityID> hits;
+        enemyManager->QueryEnemies(rockBounds, hits);
+        for (EntityID enemy : hits) {
+            LOG_DEBUG("Rock squashed an enemy!");
+            enemyManager->KillEnemy(enemy);
+            hasSquashedSomething = true;
         }
     }
     if (hasSquashedSomething) {
@@ -206,14 +227,13 @@ void Rock::startDestroyAnimation() {
         destroyAnimationStarted = true;
         tileSprite.setColor(sf::Color(255, 255, 255, 128));
         rockSprite.setColor(sf::Color(255, 255, 255, 128));
-        std::cout << "Rock destruction started" << std::endl;
+        LOG_DEBUG("Rock destruction started");
         destroyTimer = 0.0f;
     }
 }
 
 bool Rock::isSolid(float x, float y) {
-    int tileType = map->getTileAt(x, y);
-    return tileType > 0;
+    return map->isSolid(x, y);
 }
 
 void Rock::setPosition(sf::Vector2f pos) {
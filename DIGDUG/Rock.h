@@ -2,6 +2,7 @@
 #include "Entity.h"
 #include "Map.h"
 #include "Player.h"
+#include "TextureAtlas.h"
 
 class EnemyManager;
 
@@ -11,10 +12,10 @@ private:
     EnemyManager* enemyManager;
     Player* player;
 
-    sf::Sprite tileSprite;        // For the underlying tile
-    sf::Texture tileTexture;      // Tilesheet texture
-    sf::Sprite rockSprite;        // For the rock overlay
-    sf::Texture rockTexture;      // Rock-specific texture
+    GameSprite tileSprite;                       // For the underlying tile
+    TextureRegion tileSheet;                     // Tilesheet, shared with Map
+    GameSprite rockSprite;                       // For the rock overlay
+    TextureRegion rockImage;                     // Rock-specific texture
 
     float shakeTimer;
     bool isShaking;
@@ -50,6 +51,8 @@ public:
     void Update(float deltaTime, sf::Vector2f playerPosition) override;
     void Draw(sf::RenderWindow& window) override;
     void setPosition(sf::Vector2f pos) override;
+    // Puts a pooled rock back into its just-constructed state for reuse
+    void Reset(sf::Vector2f pos, int textureIndex);
 
     bool isSolid(float x, float y); // To check if it hits a solid tile
 
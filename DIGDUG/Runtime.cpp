@@ -0,0 +1,3 @@
+#include "Runtime.h"
+
+bool Runtime::headless = false;
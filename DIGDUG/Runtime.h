@@ -0,0 +1,13 @@
+#pragma once
+
+// Process-wide run mode. In headless mode nothing may touch a GPU context,
+// audio device or keyboard, so textures, sounds and input are skipped.
+class Runtime
+{
+public:
+	static bool IsHeadless() { return headless; }
+	static void SetHeadless(bool enable) { headless = enable; }
+
+private:
+	static bool headless;
+};
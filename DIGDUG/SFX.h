@@ -1,8 +1,11 @@
+#pragma once
 
-#include <SFML/Audio.hpp>
 #include <memory>
 #include <string>
 
+// A sound effect or music track. The core only holds the playback handle; the
+// frontend installs a backend that opens handles on a real audio device. Without
+// one, as in headless runs, benchmarks and tools, every SFX is silent and invalid.
 class SFX
 {
 public:
@@ -11,15 +14,31 @@ public:
         MUSIC
     };
 
+    // One open sound or music track, implemented by the audio backend
+    class Voice
+    {
+    public:
+        virtual ~Voice() = default;
+        virtual void play() = 0;
+        virtual void pause() = 0;
+        virtual void stop() = 0;
+        virtual bool isPlaying() const = 0;
+        virtual void setVolume(float volume) = 0;
+        virtual float getVolume() const = 0;
+        virtual void setLoop(bool loop) = 0;
+        virtual bool getLoop() const = 0;
+    };
+
+    // Opens a file for playback; returns null if it can't be loaded
+    using Backend = std::unique_ptr<Voice> (*)(const std::string& filename, Type audioType);
+    // Set once at startup, before any SFX is constructed
+    static void SetBackend(Backend open);
+
 private:
     Type type;
+    std::unique_ptr<Voice> voice;
 
-    // For sound effects
-    std::unique_ptr<sf::SoundBuffer> soundBuffer;
-    std::unique_ptr<sf::Sound> sound;
-
-    // For music
-    std::unique_ptr<sf::Music> music;
+    static Backend backend;
 
 public:
     // Constructor
@@ -44,4 +63,4 @@ public:
     // Utility
     Type getType() const;
     bool isValid() const;
-};
\ No newline at end of file
+};
@@ -0,0 +1,81 @@
+#include "SfmlAudio.h"
+#include "Log.h"
+#include <SFML/Audio.hpp>
+#include <unordered_map>
+
+namespace {
+    // Buffers stay alive while any sound plays from them, so each file is decoded once
+    std::unordered_map<std::string, std::weak_ptr<const sf::SoundBuffer>> soundBuffers;
+
+    std::shared_ptr<const sf::SoundBuffer> getSoundBuffer(const std::string& filename) {
+        std::weak_ptr<const sf::SoundBuffer>& entry = soundBuffers[filename];
+        if (auto shared = entry.lock()) {
+            return shared;
+        }
+        auto buffer = std::make_shared<sf::SoundBuffer>();
+        if (!buffer->loadFromFile(filename)) {
+            LOG_WARNING("Failed to load sound: " << filename);
+            return nullptr;
+        }
+        entry = buffer;
+        return buffer;
+    }
+
+    class SoundVoice : public SFX::Voice
+    {
+    public:
+        explicit SoundVoice(std::shared_ptr<const sf::SoundBuffer> buffer) : buffer(std::move(buffer)), sound(*this->buffer) {}
+
+        void play() override { sound.play(); }
+        void pause() override { sound.pause(); }
+        void stop() override { sound.stop(); }
+        bool isPlaying() const override { return sound.getStatus() == sf::Sound::Status::Playing; }
+        void setVolume(float volume) override { sound.setVolume(volume); }
+        float getVolume() const override { return sound.getVolume(); }
+        void setLoop(bool loop) override { sound.setLooping(loop); }
+        bool getLoop() const override { return sound.isLooping(); }
+
+    private:
+        std::shared_ptr<const sf::SoundBuffer> buffer;
+        sf::Sound sound;
+    };
+
+    class MusicVoice : public SFX::Voice
+    {
+    public:
+        bool open(const std::string& filename) { return music.openFromFile(filename); }
+
+        void play() override { music.play(); }
+        void pause() override { music.pause(); }
+        void stop() override { music.stop(); }
+        bool isPlaying() const override { return music.getStatus() == sf::Music::Status::Playing; }
+        void setVolume(float volume) override { music.setVolume(volume); }
+        float getVolume() const override { return music.getVolume(); }
+        void setLoop(bool loop) override { music.setLooping(loop); }
+        bool getLoop() const override { return music.isLooping(); }
+
+    private:
+        sf::Music music;
+    };
+}
+
+void SfmlAudio::Install() {
+    SFX::SetBackend(&SfmlAudio::open);
+}
+
+std::unique_ptr<SFX::Voice> SfmlAudio::open(const std::string& filename, SFX::Type audioType) {
+    if (audioType == SFX::Type::SOUND) {
+        std::shared_ptr<const sf::SoundBuffer> buffer = getSoundBuffer(filename);
+        if (!buffer) {
+            return nullptr;
+        }
+        return std::make_unique<SoundVoice>(std::move(buffer));
+    }
+
+    auto music = std::make_unique<MusicVoice>();
+    if (!music->open(filename)) {
+        LOG_WARNING("Failed to open music: " << filename);
+        return nullptr;
+    }
+    return music;
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include "SFX.h"
+
+// SFML audio backend for SFX. Part of the windowed frontend only; the core never
+// links the audio module. Sound effects playing the same file share one decoded buffer.
+class SfmlAudio
+{
+public:
+	// Routes every SFX constructed from now on to the audio device
+	static void Install();
+
+private:
+	static std::unique_ptr<SFX::Voice> open(const std::string& filename, SFX::Type audioType);
+};
@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Entity.h"
+
+// Generational handle table for densely stored objects.
+// An EntityID packs a slot index (low bits) with that slot's generation (high
+// bits). Freeing a slot bumps its generation, so handles to removed objects
+// stop resolving instead of aliasing whatever reuses the slot. The objects
+// themselves live in caller-owned dense arrays; removal swaps the last element
+// into the hole, and the table keeps slot <-> dense index in sync.
+class SlotMap
+{
+public:
+	static constexpr uint32_t INDEX_BITS = 20;                  // Up to ~1M live objects
+	static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+	static constexpr uint32_t GENERATION_MASK = (1u << (32 - INDEX_BITS)) - 1;
+
+	// Allocates a handle for the element about to be appended at dense index Size()
+	EntityID Add()
+	{
+		uint32_t slot;
+		if (freeSlots.empty()) {
+			slot = static_cast<uint32_t>(generation.size());
+			generation.push_back(1);
+			slotToDense.push_back(0);
+		}
+		else {
+			slot = freeSlots.back();
+			freeSlots.pop_back();
+		}
+		slotToDense[slot] = static_cast<uint32_t>(denseToId.size());
+		EntityID id = (generation[slot] << INDEX_BITS) | slot;
+		denseToId.push_back(id);
+		return id;
+	}
+
+	// Dense index for a live handle, or -1 if it was never issued or has been removed
+	int IndexOf(EntityID id) const
+	{
+		uint32_t slot = id & INDEX_MASK;
+		if (id == INVALID_ENTITY || slot >= generation.size() || generation[slot] != (id >> INDEX_BITS)) {
+			return -1;
+		}
+		return static_cast<int>(slotToDense[slot]);
+	}
+
+	bool Contains(EntityID id) const { return IndexOf(id) >= 0; }
+
+	// Frees the handle at `index`. The caller must mirror this on its own arrays:
+	// move element Size()-1 (as it was before the call) into `index`, then pop the back.
+	void RemoveAt(size_t index)
+	{
+		release(denseToId[index] & INDEX_MASK);
+		const EntityID moved = denseToId.back();
+		denseToId[index] = moved;
+		slotToDense[moved & INDEX_MASK] = static_cast<uint32_t>(index);
+		denseToId.pop_back();
+	}
+
+	// Invalidates every outstanding handle; slots are kept for reuse
+	void Clear()
+	{
+		for (EntityID id : denseToId) {
+			release(id & INDEX_MASK);
+		}
+		denseToId.clear();
+	}
+
+	void Reserve(size_t count)
+	{
+		denseToId.reserve(count);
+		generation.reserve(count);
+		slotToDense.reserve(count);
+		freeSlots.reserve(count);
+	}
+
+	EntityID IdAt(size_t index) const { return denseToId[index]; }
+	size_t Size() const { return denseToId.size(); }
+
+private:
+	void release(uint32_t slot)
+	{
+		// Generation 0 is never used so that no handle can equal INVALID_ENTITY
+		generation[slot] = (generation[slot] + 1) & GENERATION_MASK;
+		if (generation[slot] == 0) {
+			generation[slot] = 1;
+		}
+		freeSlots.push_back(slot);
+	}
+
+	std::vector<EntityID> denseToId;
+	std::vector<uint32_t> generation;
+	std::vector<uint32_t> slotToDense;
+	std::vector<uint32_t> freeSlots;
+};
@@ -0,0 +1,72 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+void SpatialGrid::Reset(int columns, int rows, float cellSize) {
+    this->columns = std::max(columns, 1);
+    this->rows = std::max(rows, 1);
+    this->cellSize = cellSize;
+    pending.clear();
+    ids.clear();
+    cellStart.assign(static_cast<size_t>(this->columns) * this->rows + 1, 0);
+}
+
+SpatialGrid::CellRange SpatialGrid::cellsFor(const sf::FloatRect& bounds) const {
+    auto toCell = [this](float v, int limit) {
+        int cell = static_cast<int>(std::floor(v / cellSize));
+        return std::clamp(cell, 0, limit - 1);
+    };
+    return {
+        toCell(bounds.position.x, columns),
+        toCell(bounds.position.y, rows),
+        toCell(bounds.position.x + bounds.size.x, columns),
+        toCell(bounds.position.y + bounds.size.y, rows)
+    };
+}
+
+void SpatialGrid::Insert(uint32_t id, const sf::FloatRect& bounds) {
+    pending.push_back({ id, cellsFor(bounds) });
+}
+
+void SpatialGrid::Finish() {
+    // Counting sort: size each bucket, prefix-sum into offsets, then scatter
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (const Pending& p : pending) {
+        for (int y = p.cells.minY; y <= p.cells.maxY; y++) {
+            for (int x = p.cells.minX; x <= p.cells.maxX; x++) {
+                cellStart[y * columns + x + 1]++;
+            }
+        }
+    }
+    for (size_t i = 1; i < cellStart.size(); i++) {
+        cellStart[i] += cellStart[i - 1];
+    }
+
+    ids.resize(cellStart.back());
+    cursor.assign(cellStart.begin(), cellStart.end() - 1);
+    for (const Pending& p : pending) {
+        for (int y = p.cells.minY; y <= p.cells.maxY; y++) {
+            for (int x = p.cells.minX; x <= p.cells.maxX; x++) {
+                ids[cursor[y * columns + x]++] = p.id;
+            }
+        }
+    }
+    pending.clear();
+}
+
+void SpatialGrid::Query(const sf::FloatRect& area, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (ids.empty()) {
+        return;
+    }
+    CellRange cells = cellsFor(area);
+    for (int y = cells.minY; y <= cells.maxY; y++) {
+        for (int x = cells.minX; x <= cells.maxX; x++) {
+            int cell = y * columns + x;
+            out.insert(out.end(), ids.begin() + cellStart[cell], ids.begin() + cellStart[cell + 1]);
+        }
+    }
+    // Items spanning several cells show up once per cell
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <vector>
+
+// Uniform broadphase grid. Items are registered by bounding box into every cell
+// they overlap, then Finish() packs the buckets into one contiguous array.
+// Rebuilding from scratch each tick is cheaper than tracking moves for the
+// entity counts we run, and keeps the structure trivially consistent.
+class SpatialGrid
+{
+public:
+    // Positions outside the grid are clamped into the border cells
+    void Reset(int columns, int rows, float cellSize);
+    void Insert(uint32_t id, const sf::FloatRect& bounds);
+    void Finish();
+
+    // Ids whose cells overlap the area, ascending and without duplicates.
+    // This is only a candidate set; callers still test exact bounds.
+    void Query(const sf::FloatRect& area, std::vector<uint32_t>& out) const;
+
+    bool IsEmpty() const { return ids.empty(); }
+
+private:
+    struct CellRange {
+        int minX, minY, maxX, maxY;
+    };
+    struct Pending {
+        uint32_t id;
+        CellRange cells;
+    };
+
+    CellRange cellsFor(const sf::FloatRect& bounds) const;
+
+    int columns = 0;
+    int rows = 0;
+    float cellSize = 1.0f;
+
+    std::vector<Pending> pending;
+    std::vector<uint32_t> cellStart;   // columns * rows + 1 offsets into ids
+    std::vector<uint32_t> ids;
+    std::vector<uint32_t> cursor;   // Finish() scratch, kept so rebuilds don't allocate
+};
@@ -1,87 +1,288 @@
 #include "StageManager.h"
-#include <fstream>
-#include <iostream>
+#include "Log.h"
+#include "LevelData.h"
+#include "MappedLevel.h"
 #include <filesystem>
 #include <algorithm>
+#include <map>
+#include <system_error>
+
+namespace {
+    std::filesystem::file_time_type modifiedTime(const std::string& filename) {
+        std::error_code error;
+        auto time = std::filesystem::last_write_time(filename, error);
+        return error ? std::filesystem::file_time_type{} : time;
+    }
+}
 
 StageManager::StageManager(const std::string& directory) : mapDirectory(directory) {
     loadMapList();
 }
 
 void StageManager::loadMapList() {
+    prefetched = {};
+    prefetchedLevel = -1;
     mapFiles.clear();
+    sourceFiles.clear();
+    compiledFiles.clear();
+    stages.clear();
 
     try {
+        // One stage per level name; a compiled .bmap stands in for its .rmap unless
+        // the text has been edited since it was compiled
+        std::map<std::string, std::pair<std::filesystem::path, std::filesystem::path>> filesByName;
         for (const auto& entry : std::filesystem::directory_iterator(mapDirectory)) {
-            if (entry.is_regular_file() && entry.path().extension() == ".rmap") {
-                mapFiles.push_back(entry.path().string());
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            const std::filesystem::path& path = entry.path();
+            if (path.extension() == ".rmap") {
+                filesByName[path.stem().string()].first = path;
+            }
+            else if (path.extension() == Bmap::EXTENSION) {
+                filesByName[path.stem().string()].second = path;
             }
         }
 
-        std::sort(mapFiles.begin(), mapFiles.end());
+        int compiled = 0;
+        for (const auto& [name, files] : filesByName) {
+            std::string source = files.first.string();
+            std::string binary = files.second.string();
+            mapFiles.push_back(chooseMapFile(source, binary));
+            sourceFiles.push_back(source);
+            compiledFiles.push_back(binary);
+            compiled += (!binary.empty() && mapFiles.back() == binary) ? 1 : 0;
+        }
 
-        std::cout << "Loaded " << mapFiles.size() << " map files." << std::endl;
+        LOG_INFO("Loaded " << mapFiles.size() << " map files (" << compiled << " compiled).");
     }
     catch (const std::filesystem::filesystem_error& ex) {
-        std::cerr << "Error loading maps from directory: " << ex.what() << std::endl;
+        LOG_ERROR("Error loading maps from directory: " << ex.what());
     }
+
+    stages.resize(mapFiles.size());
+    for (int level = 0; level < getMapCount(); level++) {
+        cacheStage(level);
+    }
+    pruneLevels();
+}
+
+void StageManager::pruneLevels() {
+    std::erase_if(levelsByHash, [](const auto& entry) { return entry.second.use_count() == 1; });
+}
+
+std::string StageManager::chooseMapFile(const std::string& source, const std::string& compiled) {
+    if (compiled.empty()) {
+        return source;
+    }
+    if (source.empty() || isCompiledUpToDate(source, compiled)) {
+        return compiled;
+    }
+    LOG_WARNING("Compiled map " << compiled << " is out of date; using the .rmap until it is recompiled");
+    return source;
+}
+
+bool StageManager::isCompiledUpToDate(const std::filesystem::path& source, const std::filesystem::path& binary) {
+    Bmap::Header header;
+    if (!Bmap::readHeader(binary.string(), header)) {
+        return false;
+    }
+    // A source deleted since it was compiled leaves the compiled level as the only copy
+    std::error_code error;
+    auto sourceTime = std::filesystem::last_write_time(source, error);
+    if (error) {
+        return true;
+    }
+    // Timestamps settle the common case; checkouts can leave them in either order,
+    // so fall back to comparing the source hash recorded at compile time
+    auto binaryTime = std::filesystem::last_write_time(binary, error);
+    if (!error && binaryTime >= sourceTime) {
+        return true;
+    }
+    return header.sourceHash == Bmap::hashSourceFile(source.string());
 }
 
 void StageManager::addMapFile(const std::string& filename) {
     std::string fullPath = mapDirectory + filename;
     mapFiles.push_back(fullPath);
+    sourceFiles.push_back(fullPath);
+    compiledFiles.emplace_back();
+    stages.emplace_back();
+    cacheStage(getMapCount() - 1);
 }
 
-std::string StageManager::getMapFile(int level) const {
-    if (level < 0 || level >= mapFiles.size()) {
-        std::cerr << "Invalid level: " << level << ". Available levels: 0-" << (mapFiles.size() - 1) << std::endl;
-        return "";
+bool StageManager::cacheStage(int level) {
+    CachedStage& stage = stages[level];
+    const std::string& filename = mapFiles[level];
+    stage.compiledModified = compiledFiles[level].empty() ? std::filesystem::file_time_type{} : modifiedTime(compiledFiles[level]);
+    stage.sourceModified = sourceFiles[level].empty() ? std::filesystem::file_time_type{} : modifiedTime(sourceFiles[level]);
+    stage.sourceText.reset();
+
+    // Look the content up by hash before doing any parsing. A compiled level records
+    // the hash of its source, so it shares an entry with the .rmap it was built from.
+    uint64_t hash = 0;
+    std::shared_ptr<const ParsedLevel> content;
+    if (filename.ends_with(Bmap::EXTENSION)) {
+        Bmap::Header header;
+        if (Bmap::readHeader(filename, header)) {
+            hash = header.sourceHash;
+            auto cached = levelsByHash.find(hash);
+            if (cached != levelsByHash.end()) {
+                content = cached->second;
+            }
+            else {
+                MappedLevel mapped;
+                if (mapped.open(filename)) {
+                    auto parsed = std::make_shared<ParsedLevel>();
+                    parsed->assign(mapped.data(), hash);
+                    content = std::move(parsed);
+                }
+            }
+        }
     }
-    return mapFiles[level];
+    else {
+        auto text = std::make_shared<std::string>();
+        if (ParsedLevel::readText(filename, *text)) {
+            hash = Bmap::hashSource(*text);
+            auto cached = levelsByHash.find(hash);
+            if (cached != levelsByHash.end()) {
+                content = cached->second;
+            }
+            else {
+                auto parsed = std::make_shared<ParsedLevel>();
+                if (parsed->parse(*text, filename)) {
+                    content = std::move(parsed);
+                }
+            }
+            stage.sourceText = std::move(text);
+        }
+    }
+
+    stage.level = content;
+    stage.info = StageInfo{};
+    if (!content) {
+        LOG_ERROR("Could not load map file: " << filename);
+        return false;
+    }
+    levelsByHash[hash] = content;
+
+    LevelData data = content->view();
+    stage.info.width = data.width;
+    stage.info.height = data.height;
+    stage.info.rockCount = static_cast<int>(data.rocks.size());
+    for (const LevelSpawn& spawn : data.spawns) {
+        stage.info.enemyCount += spawn.type == 'P' ? 1 : 0;
+        stage.info.hasPlayerStart |= spawn.type == '*';
+    }
+    stage.info.contentHash = hash;
+    return true;
 }
 
-std::string StageManager::loadMapData(int level) const {
-    std::string filename = getMapFile(level);
+std::vector<int> StageManager::reloadChanged() {
+    std::vector<int> changed;
+    for (int level = 0; level < getMapCount(); level++) {
+        CachedStage& stage = stages[level];
+        const std::string& source = sourceFiles[level];
+        const std::string& compiled = compiledFiles[level];
+        bool compiledTouched = !compiled.empty() && modifiedTime(compiled) != stage.compiledModified;
+        bool sourceTouched = !source.empty() && modifiedTime(source) != stage.sourceModified;
+        if (!compiledTouched && !sourceTouched) {
+            continue;
+        }
+
+        // An edited .rmap takes over from its compiled level, and a recompile hands it back
+        std::string chosen = chooseMapFile(source, compiled);
+        if (chosen != mapFiles[level]) {
+            if (chosen == compiled) {
+                LOG_INFO("Stage " << level << " is compiled again: " << compiled);
+            }
+            mapFiles[level] = std::move(chosen);
+        }
+
+        uint64_t previousHash = stage.info.contentHash;
+        cacheStage(level);
+        if (stage.info.contentHash != previousHash) {
+            changed.push_back(level);
+            LOG_INFO("Stage " << level << " changed on disk: " << mapFiles[level]);
+            if (prefetchedLevel == level) {
+                prefetched = {};
+                prefetchedLevel = -1;
+            }
+        }
+    }
+    if (!changed.empty()) {
+        pruneLevels();
+    }
+    return changed;
+}
+
+const StageManager::StageInfo* StageManager::getStageInfo(int level) const {
+    if (level < 0 || level >= getMapCount()) {
+        return nullptr;
+    }
+    return &stages[level].info;
+}
+
+std::shared_ptr<const ParsedLevel> StageManager::getLevel(int level) const {
+    if (level < 0 || level >= getMapCount()) {
+        return nullptr;
+    }
+    return stages[level].level;
+}
+
+const std::string* StageManager::getSourceText(int level) const {
+    std::string filename = getSourceFile(level);
     if (filename.empty()) {
-        return "";
+        return nullptr;
     }
+    const CachedStage& stage = stages[level];
+    if (!stage.sourceText) {
+        auto text = std::make_shared<std::string>();
+        if (!ParsedLevel::readText(filename, *text)) {
+            LOG_ERROR("Could not open map file: " << filename);
+            return nullptr;
+        }
+        stage.sourceText = std::move(text);
+    }
+    return stage.sourceText.get();
+}
 
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Could not open map file: " << filename << std::endl;
+std::string StageManager::getMapFile(int level) const {
+    if (level < 0 || level >= mapFiles.size()) {
+        LOG_ERROR("Invalid level: " << level << ". Available levels: 0-" << (mapFiles.size() - 1));
         return "";
     }
+    return mapFiles[level];
+}
 
-    std::string mapData;
-    std::string line;
-    while (std::getline(file, line)) {
-        mapData += line + "\n";
+std::string StageManager::getSourceFile(int level) const {
+    if (getMapFile(level).empty()) {
+        return "";
     }
-    file.close();
+    return sourceFiles[level];
+}
 
-    return mapData;
+std::string StageManager::loadMapData(int level) const {
+    const std::string* text = getSourceText(level);
+    return text ? *text : "";
 }
 
 std::vector<std::string> StageManager::loadMapLines(int level) const {
-    std::string filename = getMapFile(level);
     std::vector<std::string> lines;
-
-    if (filename.empty()) {
+    const std::string* text = getSourceText(level);
+    if (!text) {
         return lines;
     }
 
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "Could not open map file: " << filename << std::endl;
-        return lines;
-    }
-
-    std::string line;
-    while (std::getline(file, line)) {
-        lines.push_back(line);
+    size_t start = 0;
+    while (start < text->size()) {
+        size_t end = text->find('\n', start);
+        if (end == std::string::npos) {
+            end = text->size();
+        }
+        lines.emplace_back(*text, start, end - start);
+        start = end + 1;
     }
-    file.close();
-
     return lines;
 }
 
@@ -94,10 +295,47 @@ const std::vector<std::string>& StageManager::getMapFiles() const {
 }
 
 void StageManager::printAvailableMaps() const {
-    std::cout << "Available maps:" << std::endl;
+    LOG_INFO("Available maps:");
     for (int i = 0; i < mapFiles.size(); ++i) {
-        std::cout << "Level " << i << ": " << mapFiles[i] << std::endl;
+        const StageInfo& info = stages[i].info;
+        LOG_INFO("Level " << i << ": " << mapFiles[i] << " (" << info.width << "x" << info.height << ", "
+            << info.enemyCount << " enemies, " << info.rockCount << " rocks)");
+    }
+}
+
+int StageManager::getNextStage() const {
+    return currentStage >= getMapCount() ? currentStage - 1 : currentStage + 1;
+}
+
+void StageManager::prefetch(int level) {
+    if (prefetched.valid() && prefetchedLevel == level) {
+        return;
+    }
+    std::shared_ptr<const ParsedLevel> cached = getLevel(level);
+    if (!cached) {
+        prefetched = {};
+        prefetchedLevel = -1;
+        return;
+    }
+    // The worker holds its own reference to the cached level, so a reload on this
+    // thread can't pull the data out from under it
+    prefetchedLevel = level;
+    prefetched = std::async(std::launch::async, [level, cached]() {
+        auto stage = std::make_unique<Map::Stage>();
+        Map::prepareStage(cached->view(), level, *stage);
+        return stage;
+    });
+}
+
+std::unique_ptr<Map::Stage> StageManager::takeStage(int level) {
+    if (!prefetched.valid() || prefetchedLevel != level) {
+        prefetch(level);
+    }
+    if (!prefetched.valid()) {
+        return nullptr;
     }
+    prefetchedLevel = -1;
+    return prefetched.get();
 }
 
 void StageManager::incrementStage()
@@ -105,7 +343,7 @@ void StageManager::incrementStage()
     
     if (currentStage >= getMapCount()) {
         currentStage -= 1;
-        std::cout << "All stages completed! Restarting from the last stage" << std::endl;
+        LOG_INFO("All stages completed! Restarting from the last stage");
         return;
     }
     else if (currentStage < getMapCount()){
@@ -119,7 +357,7 @@ void StageManager::setCurrentStage(int level)
         currentStage = level;
     }
     else {
-        std::cout << "setCurrentStage in stagemanager failed, level does not exist in map file." << std::endl;
+        LOG_WARNING("setCurrentStage in stagemanager failed, level does not exist in map file.");
     }
 
 }
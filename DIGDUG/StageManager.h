@@ -1,27 +1,89 @@
 #pragma once
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include "LevelData.h"
+#include "Map.h"
 
 class StageManager
 {
+public:
+    // Index entry per stage, filled when the stage is cached
+    struct StageInfo {
+        uint16_t width = 0;
+        uint16_t height = 0;
+        int enemyCount = 0;
+        int rockCount = 0;
+        bool hasPlayerStart = false;
+        uint64_t contentHash = 0;   // Bmap::hashSource of the level text; 0 if it failed to load
+    };
+
 private:
-	std::vector<std::string> mapFiles;
-	std::string mapDirectory; 
+	std::vector<std::string> mapFiles;     // File each stage loads from: compiled .bmap when up to date, else .rmap
+	std::vector<std::string> sourceFiles;  // The .rmap text per stage, empty for compiled-only stages
+	std::vector<std::string> compiledFiles;  // The .bmap per stage, empty if it was never compiled
+	std::string mapDirectory;
     int currentStage = 0;
 
+    // Every stage is read once when listed and served from memory afterwards.
+    // Parsed levels are shared by content hash, so identical files, or a file edited
+    // and then reverted, are only parsed once.
+    struct CachedStage {
+        StageInfo info;
+        std::shared_ptr<const ParsedLevel> level;                  // Null if the file could not be loaded
+        mutable std::shared_ptr<const std::string> sourceText;     // Read on first use for compiled stages
+        std::filesystem::file_time_type compiledModified{};
+        std::filesystem::file_time_type sourceModified{};
+    };
+    std::vector<CachedStage> stages;   // Parallel to mapFiles
+    std::unordered_map<uint64_t, std::shared_ptr<const ParsedLevel>> levelsByHash;
+
+    // Stage being prepared in the background, at most one at a time
+    int prefetchedLevel = -1;
+    std::future<std::unique_ptr<Map::Stage>> prefetched;
+
+    static bool isCompiledUpToDate(const std::filesystem::path& source, const std::filesystem::path& binary);
+    // The file a stage should load from: its .bmap unless the .rmap has been edited since
+    static std::string chooseMapFile(const std::string& source, const std::string& compiled);
+    // Forget levels no stage refers to any more
+    void pruneLevels();
+    bool cacheStage(int level);
+    const std::string* getSourceText(int level) const;
+
 public:
 		StageManager(const std::string& directory = "Assets/Map");
         void loadMapList();
         void addMapFile(const std::string& filename);
         std::string getMapFile(int level) const;
+        std::string getSourceFile(int level) const;
         std::string loadMapData(int level) const;
         std::vector<std::string> loadMapLines(int level) const;
         int getMapCount() const;
         const std::vector<std::string>& getMapFiles() const;
+        // Metadata for a stage without loading anything; null for an invalid level
+        const StageInfo* getStageInfo(int level) const;
+        // The cached level; null if it failed to load
+        std::shared_ptr<const ParsedLevel> getLevel(int level) const;
+        // Re-reads stages whose files have a new modification time and returns those
+        // whose content actually changed. A stage moves between its .rmap and .bmap as
+        // either is edited or recompiled. Added or removed files need loadMapList().
+        std::vector<int> reloadChanged();
         void printAvailableMaps() const;
         void incrementStage();
         void setCurrentStage(int level);
         int getCurrentStage() const { return currentStage; }
-        
-};
+        // The stage incrementStage() would move to
+        int getNextStage() const;
 
+        // Start preparing a stage on a worker thread: spawn tables, texture indices,
+        // vertices and tunnel index, from the cached level. Replaces any other pending
+        // prefetch.
+        void prefetch(int level);
+        // The prepared stage, waiting for the worker if it is still busy, or prepares it now if it
+        // was never prefetched. Null if the level can't be loaded.
+        std::unique_ptr<Map::Stage> takeStage(int level);
+};
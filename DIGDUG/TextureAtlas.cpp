@@ -0,0 +1,143 @@
+#include "TextureAtlas.h"
+#include "AssetCache.h"
+#include "Log.h"
+#include "Runtime.h"
+#include <algorithm>
+#include <vector>
+
+std::shared_ptr<const sf::Texture> TextureAtlas::texture;
+std::unordered_map<std::string, sf::IntRect, TextureAtlas::PathHash, std::equal_to<>> TextureAtlas::regions;
+
+namespace {
+    struct Source {
+        std::string_view path;
+        sf::Image image;
+        sf::Vector2u position;   // Top-left of the image itself, inside its padding
+    };
+
+    // Copies the image to position and repeats its outermost pixels into the padding around it
+    void blit(sf::Image& atlas, const sf::Image& image, sf::Vector2u position, int padding) {
+        const sf::Vector2u size = image.getSize();
+        const int width = static_cast<int>(size.x);
+        const int height = static_cast<int>(size.y);
+        bool copied = atlas.copy(image, position);
+        for (int p = 1; p <= padding; p++) {
+            copied &= atlas.copy(image, { position.x - p, position.y }, sf::IntRect({ 0, 0 }, { 1, height }));
+            copied &= atlas.copy(image, { position.x + size.x + p - 1, position.y }, sf::IntRect({ width - 1, 0 }, { 1, height }));
+            copied &= atlas.copy(image, { position.x, position.y - p }, sf::IntRect({ 0, 0 }, { width, 1 }));
+            copied &= atlas.copy(image, { position.x, position.y + size.y + p - 1 }, sf::IntRect({ 0, height - 1 }, { width, 1 }));
+        }
+        for (unsigned y = 0; y < static_cast<unsigned>(padding); y++) {
+            for (unsigned x = 0; x < static_cast<unsigned>(padding); x++) {
+                atlas.setPixel({ position.x - 1 - x, position.y - 1 - y }, image.getPixel({ 0, 0 }));
+                atlas.setPixel({ position.x + size.x + x, position.y - 1 - y }, image.getPixel({ size.x - 1, 0 }));
+                atlas.setPixel({ position.x - 1 - x, position.y + size.y + y }, image.getPixel({ 0, size.y - 1 }));
+                atlas.setPixel({ position.x + size.x + x, position.y + size.y + y }, image.getPixel({ size.x - 1, size.y - 1 }));
+            }
+        }
+        if (!copied) {
+            LOG_WARNING("Texture atlas: image only partly copied");
+        }
+    }
+}
+
+bool TextureAtlas::Build(std::initializer_list<std::string_view> paths) {
+    Clear();
+    if (Runtime::IsHeadless()) {
+        return false;
+    }
+
+    std::vector<Source> sources;
+    sources.reserve(paths.size());
+    for (std::string_view path : paths) {
+        sf::Image image;
+        if (!image.loadFromFile(std::string(path))) {
+            LOG_WARNING("Texture atlas: failed to load image: " << path);
+            continue;
+        }
+        if (image.getSize().x == 0 || image.getSize().y == 0) {
+            continue;
+        }
+        sources.push_back({ path, std::move(image), {} });
+    }
+    if (sources.empty()) {
+        return false;
+    }
+
+    // Shelf packing, tallest first: with a handful of strip-shaped sheets this wastes little
+    std::vector<Source*> order;
+    unsigned area = 0;
+    unsigned widest = 0;
+    for (Source& source : sources) {
+        order.push_back(&source);
+        sf::Vector2u padded = source.image.getSize() + sf::Vector2u(2 * PADDING, 2 * PADDING);
+        area += padded.x * padded.y;
+        widest = std::max(widest, padded.x);
+    }
+    std::stable_sort(order.begin(), order.end(), [](const Source* a, const Source* b) {
+        return a->image.getSize().y > b->image.getSize().y;
+    });
+
+    unsigned width = 64;
+    while (width < widest || width * width < area) {
+        width *= 2;
+    }
+    unsigned x = 0;
+    unsigned y = 0;
+    unsigned shelfHeight = 0;
+    for (Source* source : order) {
+        sf::Vector2u padded = source->image.getSize() + sf::Vector2u(2 * PADDING, 2 * PADDING);
+        if (x + padded.x > width) {
+            x = 0;
+            y += shelfHeight;
+            shelfHeight = 0;
+        }
+        source->position = { x + PADDING, y + PADDING };
+        x += padded.x;
+        shelfHeight = std::max(shelfHeight, padded.y);
+    }
+    const unsigned height = y + shelfHeight;
+    const unsigned maximumSize = sf::Texture::getMaximumSize();
+    if (width > maximumSize || height > maximumSize) {
+        LOG_WARNING("Texture atlas of " << width << "x" << height << " exceeds the maximum texture size " << maximumSize);
+        return false;
+    }
+
+    sf::Image atlas({ width, height }, sf::Color::Transparent);
+    for (const Source& source : sources) {
+        blit(atlas, source.image, source.position, PADDING);
+    }
+    auto packed = std::make_shared<sf::Texture>();
+    if (!packed->loadFromImage(atlas)) {
+        LOG_WARNING("Texture atlas: failed to create a " << width << "x" << height << " texture");
+        return false;
+    }
+
+    texture = packed;
+    for (const Source& source : sources) {
+        regions.emplace(std::string(source.path), sf::IntRect(sf::Vector2i(source.position), sf::Vector2i(source.image.getSize())));
+    }
+    LOG_INFO("Packed " << sources.size() << " images into a " << width << "x" << height << " texture atlas");
+    return true;
+}
+
+TextureRegion TextureAtlas::GetRegion(std::string_view path) {
+    if (Runtime::IsHeadless()) {
+        return {};
+    }
+    auto it = regions.find(path);
+    if (it != regions.end()) {
+        return { texture, it->second.position, it->second.size };
+    }
+    std::shared_ptr<const sf::Texture> single = AssetCache::GetTexture(path);
+    return { single, { 0, 0 }, single ? sf::Vector2i(single->getSize()) : sf::Vector2i() };
+}
+
+void TextureAtlas::Clear() {
+    texture = nullptr;
+    regions.clear();
+}
+
+sf::Vector2u TextureAtlas::GetSize() {
+    return texture ? texture->getSize() : sf::Vector2u();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Where one source image lives: the texture to bind and the image's top-left corner in it.
+// Callers keep working in the image's own pixel coordinates and shift them by offset.
+struct TextureRegion
+{
+	std::shared_ptr<const sf::Texture> texture;   // Null in headless mode or if the image failed to load
+	sf::Vector2i offset;
+	sf::Vector2i size;   // Of the source image
+
+	sf::IntRect bounds() const { return sf::IntRect(offset, size); }
+	sf::IntRect map(const sf::IntRect& rect) const { return sf::IntRect(rect.position + offset, rect.size); }
+	sf::Vector2f map(sf::Vector2f texCoords) const { return texCoords + sf::Vector2f(offset); }
+};
+
+// Sprite sheets packed into a single texture at startup, so the map, rocks, player and
+// enemies all draw from one texture and consecutive draws never rebind it.
+// Images that were not packed come from AssetCache with a zero offset. Like AssetCache,
+// nothing is loaded in headless mode. Used from the main thread only.
+class TextureAtlas
+{
+public:
+	// Packs the images into a new atlas, replacing the current one. Needs a GL context, so
+	// call it once the window exists. Images that fail to load are left out.
+	static bool Build(std::initializer_list<std::string_view> paths);
+	static TextureRegion GetRegion(std::string_view path);
+	static void Clear();
+	// Zero until Build() succeeds
+	static sf::Vector2u GetSize();
+
+private:
+	static constexpr int PADDING = 1;   // Edge pixels repeated around each image so filtering never reaches a neighbour
+
+	struct PathHash {
+		using is_transparent = void;
+		size_t operator()(std::string_view path) const { return std::hash<std::string_view>{}(path); }
+	};
+
+	static std::shared_ptr<const sf::Texture> texture;
+	static std::unordered_map<std::string, sf::IntRect, PathHash, std::equal_to<>> regions;
+};
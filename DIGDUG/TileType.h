@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+
+// Terrain stored in each map cell. Values match the digits used in .rmap files.
+enum class TileType : uint8_t {
+    Empty = 0,    // Tunnel / open space
+    Surface = 1,
+    Dirt1 = 2,
+    Dirt2 = 3,
+    Dirt3 = 4,
+    Dirt4 = 5,
+    OutOfBounds = 0xFF  // Returned by queries outside the grid
+};
+constexpr int TILE_TYPE_COUNT = 6;  // Empty..Dirt4
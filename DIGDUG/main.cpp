@@ -1,31 +1,141 @@
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
-#include "Player.h"
-#include "Map.h"
-#include "Pooka.h"
-#include "Rock.h"
-#include "EnemyManager.h"
-#include "GameState.h"
-#include "StageManager.h"
+#include <random>
+#include <string>
+#include "Game.h"
+#include "Runtime.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "ProfilerOverlay.h"
+#include "SfmlAudio.h"
+#include "TextureAtlas.h"
+
+// Runs the simulation for a fixed number of ticks with no window, GPU context or
+// audio device and reports throughput. Ticks are Game::FIXED_TIMESTEP long and run
+// back to back, as fast as the CPU allows. With a replay, runs until it is exhausted
+// unless a tick count is given. With --profile, each tick is one profiler frame and the
+// last Profiler::FRAME_HISTORY ticks are written out as a Chrome trace at the end.
+// Usage: DIGDUG --headless [ticks] [--seed <n>] [--record <file>] [--replay <file>] [--profile <file>]
+static int runHeadless(int ticks, uint64_t seed, const std::string& recordFile, const std::string& replayFile, const std::string& profileFile)
+{
+    Runtime::SetHeadless(true);
+    // Per-event gameplay chatter would dominate the measurement
+    Log::SetLevel(LogLevel::Warning);
+
+    Game game(seed);
+    if (!replayFile.empty() && !game.StartReplay(replayFile)) {
+        return -1;
+    }
+    if (!recordFile.empty() && !game.StartRecording(recordFile)) {
+        return -1;
+    }
+    if (!game.Initialise()) {
+        return -1;
+    }
+
+    const float deltaTime = Game::FIXED_TIMESTEP;
+    auto start = std::chrono::steady_clock::now();
+    int tick = 0;
+    while ((ticks > 0) ? tick < ticks : game.IsReplaying() && !game.IsReplayFinished()) {
+        Profiler::BeginFrame();
+        game.Update(deltaTime);
+        Profiler::EndFrame();
+        tick++;
+    }
+    auto end = std::chrono::steady_clock::now();
 
-int main()
+    if (!profileFile.empty()) {
+        Profiler::ExportChromeTrace(profileFile);
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    Log::Flush();
+    std::cout << "Headless: " << tick << " ticks (" << (tick * deltaTime) << "s simulated) in "
+        << seconds << "s, " << (tick / seconds) << " ticks/s, "
+        << game.getStagesPlayed() << " stages played, seed " << game.getSeed()
+        << ", " << game.getLastRespawnAllocations() << " allocations on last respawn" << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv)
 {
+    // --seed <n> makes a run reproducible; headless defaults to a fixed seed,
+    // the windowed game to a random one
+    bool headless = argc > 1 && std::strcmp(argv[1], "--headless") == 0;
+    uint64_t seed = headless ? 1 : std::random_device{}();
+    // --record <file> captures every tick's input; --replay <file> plays one back
+    // (and its seed) instead of reading the keyboard
+    std::string recordFile;
+    std::string replayFile;
+    // --profile <file> turns the profiler on from the start and writes a Chrome trace
+    // (chrome://tracing, Perfetto) of the most recent frames on exit
+    std::string profileFile;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            recordFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replayFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profileFile = argv[++i];
+        }
+    }
+    Profiler::SetEnabled(!profileFile.empty());
+
+    if (headless) {
+        int ticks = replayFile.empty() ? 100000 : 0;
+        if (argc > 2 && argv[2][0] != '-') {
+            char* end = nullptr;
+            long parsed = std::strtol(argv[2], &end, 10);
+            if (end == argv[2] || *end != '\0' || parsed > INT_MAX || parsed < INT_MIN) {
+                LOG_ERROR("Invalid tick count: " << argv[2]);
+                Log::Flush();
+                return -1;
+            }
+            ticks = static_cast<int>(parsed);
+        }
+        // Without a replay there is nothing else to end the run
+        if (ticks <= 0 && replayFile.empty()) {
+            LOG_ERROR("Headless runs need a positive tick count unless replaying");
+            Log::Flush();
+            return -1;
+        }
+        return runHeadless(ticks, seed, recordFile, replayFile, profileFile);
+    }
+
+    // Optional flags for the windowed game: --speed <scale> runs the simulation
+    // faster or slower than real time, --no-interpolation draws raw step positions
+    float timeScale = 1.0f;
+    bool interpolate = true;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            timeScale = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--no-interpolation") == 0) {
+            interpolate = false;
+        }
+    }
+
     // - - - - - - - - - - - - Initialise - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+    // Sounds play through SFML audio; headless runs never install it and stay silent
+    SfmlAudio::Install();
     sf::ContextSettings settings;
     sf::RenderWindow window(sf::VideoMode({ 224, 270 }), "DIG DUG", sf::Style::Default, sf::State::Windowed, settings);
 
     sf::Font font;
     if (!font.openFromFile("Assets/Fonts/arial.ttf")) {
-        std::cerr << "Failed to load font!" << std::endl;
+        LOG_ERROR("Failed to load font!");
         return -1;
     }
 
-    SFX victory("Assets/Sounds/Music/success.mp3");
-    victory.setVolume(30);
-
-    // Initialize StageManager
-    StageManager stageManager("Assets/Map/");
-
     // Create text objects
     sf::Text startText(font, "");
     startText.setString("Stage Start");
@@ -45,393 +155,95 @@ int main()
     lossText.setFillColor(sf::Color::Red);
     lossText.setPosition(sf::Vector2f(112, 50));
 
-  
-
-    // Load start scene music
-    SFX lossMusic("Assets/Sounds/Music/loss.mp3", SFX::Type::MUSIC);
-    SFX noLivesMusic("Assets/Sounds/Music/nolivesleft.mp3", SFX::Type::MUSIC);
-    SFX startMusic("Assets/Sounds/Music/start_music.mp3", SFX::Type::MUSIC);
-    startMusic.setLoop(false); lossMusic.setLoop(false); noLivesMusic.setLoop(false);
-    startMusic.setVolume(35); lossMusic.setVolume(35); noLivesMusic.setVolume(35);
-
-    sf::Clock clock;
-    GameState gameState;
-    gameState.setGameState(States::START);
-
-    float winDelayTimer = 0.0f;
-    float startDelayTimer = 0.0f;
-    float startPauseTimer = 0.0f;
-    float lossDelayTimer = 0.0f;
-    const float START_DELAY = 8.0f;
-    const float WIN_DELAY = 3.0f;
-    const float START_PAUSE_DELAY = 1.0f;
-    const float LOSS_DELAY = 6.0f;
-    int startSceneStep = 0;
-    int TOTAL_START_STEPS = 0;
-    bool startMovementComplete = false;
-    bool startSceneInitialized = false;
-    bool startPauseComplete = false;
-    bool movingHorizontally = true;
-    bool lossSceneInitialized = false;
-    int horizontalSteps = 0;
-    int verticalSteps = 0;
-
-    Map map;
-    Player player(&map);
-    player.SetGameState(&gameState);
-    EnemyManager enemyManager(&map, &player, 10);
-    enemyManager.SetGameState(&gameState);
-    player.SetEnemyManager(&enemyManager);
-
     sf::Text livesText(font, "");
     livesText.setCharacterSize(10);
     livesText.setFillColor(sf::Color::Red);
     livesText.setPosition(sf::Vector2f(112,16));
 
-    // Load initial map using StageManager
-    std::string mapFile = stageManager.getMapFile(stageManager.getCurrentStage());
-    if (!mapFile.empty()) {
-        map.loadFromFile(mapFile);
+    // F3 toggles the profiler overlay, F4 saves a trace of the recent frames
+    ProfilerOverlay profilerOverlay(font);
+    const std::string traceFile = profileFile.empty() ? "profile.json" : profileFile;
+
+    // - - - - - - - - - - - - Load - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
+    // Every sprite sheet in one texture, so the whole scene draws without switching textures.
+    // Has to happen before Game is constructed: the Map picks up its tilesheet region there.
+    TextureAtlas::Build({
+        "Assets/Map/tilesheet.png",
+        "Assets/Map/rock.png",
+        "Assets/Sprites/Player/spritesheet1.png",
+        "Assets/Sprites/Player/harpoon.png",
+        "Assets/Sprites/Pooka/spritesheet.png",
+    });
+
+    Game game(seed);
+    if (!replayFile.empty() && !game.StartReplay(replayFile)) {
+        return -1;
     }
-    else {
-        std::cerr << "No maps available!" << std::endl;
+    if (!recordFile.empty() && !game.StartRecording(recordFile)) {
         return -1;
     }
-
-    player.Initialise();
-    enemyManager.Initialise();
-    int const TILE_SIZE = 16;
-
-    // - - - - - - - - - - - - Load - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
-
-    // Initialize player at (-16, 16)
-    sf::Vector2f initialPos(-16, 16);
-    sf::Vector2f startPos;
-    const auto& spawns = map.getEntitySpawns();
-    for (const auto& spawn : spawns) {
-        if (spawn.first == '*') {
-            startPos = spawn.second;
-            break;
-        }
+    if (!game.Initialise()) {
+        return -1;
     }
+    LOG_INFO("Seed: " << game.getSeed());
+    game.SetTimeScale(timeScale);
+    game.SetInterpolation(interpolate);
 
-    // Calculate total steps needed
-    float horizontalDistance = abs(startPos.x - (-16));
-    horizontalSteps = static_cast<int>(horizontalDistance / TILE_SIZE);
-    float verticalDistance = startPos.y - 16;
-    verticalSteps = static_cast<int>(verticalDistance / TILE_SIZE);
-    TOTAL_START_STEPS = horizontalSteps + verticalSteps;
-
-    player.setPlayerInitialPosition(initialPos);
-    player.SetCreateTunnels(false);
-    player.Load();
-
-    enemyManager.SpawnEnemiesFromMap();
-    enemyManager.SpawnRocksFromMap();
-    map.printInfo();
-    startMusic.play();
-
+    sf::Clock clock;
     while (window.isOpen())
     {
         // - - - - - - - - - - - - Update - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
         sf::Time deltaTimeTimer = clock.restart();
         float deltaTime = deltaTimeTimer.asSeconds();
-
-        sf::Vector2f mousePosition = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+        Profiler::BeginFrame();
 
         while (const std::optional event = window.pollEvent())
         {
             if (event->is<sf::Event::Closed>())
                 window.close();
-        }
-
-        static States previousState = gameState.getGameState();
-        switch (gameState.getGameState())
-        {
-        case States::START:
-        {
-            // Initialize start scene on first entry
-            if (!startSceneInitialized) {
-                // Recalculate steps in case map changed
-                float horizontalDistance = abs(startPos.x - (-16));
-                horizontalSteps = static_cast<int>(horizontalDistance / TILE_SIZE);
-                float verticalDistance = startPos.y - 16;
-                verticalSteps = static_cast<int>(verticalDistance / TILE_SIZE);
-                TOTAL_START_STEPS = horizontalSteps + verticalSteps;
-
-                // Fully reset player position
-                player.setPosition(initialPos);
-                player.setPlayerInitialPosition(initialPos);
-                player.setTargetPosition(initialPos);
-                player.setIsMoving(false);
-                player.DetachHarpoon();
-                player.SetCreateTunnels(false);
-                player.setHealth(1); // Reset health
-                startSceneStep = 0;
-                startMovementComplete = false;
-                startSceneInitialized = true;
-                startDelayTimer = 0.0f;
-                startPauseTimer = 0.0f;
-                startPauseComplete = false;
-                movingHorizontally = true;
-                startMusic.play();
-                std::cout << "START scene initialized: Player reset to (" << initialPos.x << ", " << initialPos.y << ")" << std::endl;
-            }
-
-            startDelayTimer += deltaTime;
-
-            // Handle initial pause
-            if (!startPauseComplete) {
-                startPauseTimer += deltaTime;
-                if (startPauseTimer >= START_PAUSE_DELAY) {
-                    startPauseComplete = true;
-                    // Set first target based on whether we need horizontal movement
-                    if (horizontalSteps > 0) {
-                        // Move horizontally first
-                        sf::Vector2f nextTarget(-16 + TILE_SIZE, 16);
-                        nextTarget.x = std::floor(nextTarget.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        nextTarget.y = std::floor(nextTarget.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        player.setTargetPosition(nextTarget);
-                        player.SetCreateTunnels(false); // No tunnels on surface
-                        movingHorizontally = true;
-                        startSceneStep = 1;
-                    }
-                    else {
-                        // Go straight to vertical movement
-                        sf::Vector2f nextTarget(startPos.x, 32);
-                        nextTarget.x = std::floor(nextTarget.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        nextTarget.y = std::floor(nextTarget.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        player.setTargetPosition(nextTarget);
-                        player.SetCreateTunnels(true); // Create tunnels when digging
-                        movingHorizontally = false;
-                        startSceneStep = 1;
-                    }
-                    std::cout << "START scene: Pause complete, starting movement" << std::endl;
-                }
-            }
-
-            // Update player movement if pause is complete and movement not yet complete
-            if (startPauseComplete && !startMovementComplete) {
-                player.Update(deltaTime, player.getPlayerPosition());
-
-                // Check if player has reached the current target position
-                if (!player.getIsMoving() && startSceneStep < TOTAL_START_STEPS) {
-                    startSceneStep++;
-
-                    if (movingHorizontally && startSceneStep <= horizontalSteps) {
-                        // Continue horizontal movement
-                        float nextX = -16 + startSceneStep * TILE_SIZE;
-                        sf::Vector2f nextTarget(nextX, 16);
-                        nextTarget.x = std::floor(nextTarget.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        nextTarget.y = std::floor(nextTarget.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        player.setTargetPosition(nextTarget);
-                        std::cout << "START scene: Moving horizontally to (" << nextTarget.x << ", " << nextTarget.y << ")" << std::endl;
-                    }
-                    else if (movingHorizontally && startSceneStep > horizontalSteps) {
-                        // Switch to vertical movement
-                        movingHorizontally = false;
-                        player.SetCreateTunnels(true); // Enable tunnels for digging
-                        float nextY = 16 + (startSceneStep - horizontalSteps) * TILE_SIZE;
-                        sf::Vector2f nextTarget(startPos.x, nextY);
-                        nextTarget.x = std::floor(nextTarget.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        nextTarget.y = std::floor(nextTarget.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        player.setTargetPosition(nextTarget);
-                        std::cout << "START scene: Starting vertical movement to (" << nextTarget.x << ", " << nextTarget.y << ")" << std::endl;
-                    }
-                    else if (!movingHorizontally) {
-                        // Continue vertical movement
-                        float nextY = 16 + (startSceneStep - horizontalSteps) * TILE_SIZE;
-                        sf::Vector2f nextTarget(startPos.x, nextY);
-                        nextTarget.x = std::floor(nextTarget.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        nextTarget.y = std::floor(nextTarget.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                        player.setTargetPosition(nextTarget);
-                        std::cout << "START scene: Moving down to (" << nextTarget.x << ", " << nextTarget.y << ")" << std::endl;
-                    }
-                }
-                else if (!player.getIsMoving() && startSceneStep >= TOTAL_START_STEPS) {
-                    // Movement complete
-                    startMovementComplete = true;
-                    sf::Vector2f finalPos(startPos.x, startPos.y);
-                    finalPos.x = std::floor(finalPos.x / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                    finalPos.y = std::floor(finalPos.y / TILE_SIZE) * TILE_SIZE + TILE_SIZE / 2.0f;
-                    player.setPosition(finalPos);
-                    player.setTargetPosition(finalPos);
-                    player.SetCreateTunnels(true);
-                    std::cout << "START scene: Movement complete at (" << finalPos.x << ", " << finalPos.y << ")" << std::endl;
-                    player.resetTransform();
-                }
-            }
-
-            if (startDelayTimer >= START_DELAY) {
-                gameState.setGameState(States::GAME);
-                startMusic.stop();
-                startSceneInitialized = false;
-                std::cout << "Transitioning to GAME state" << std::endl;
-            }
-            break;
-        }
-        case States::GAME:
-        {
-            player.Update(deltaTime, player.getPlayerPosition());
-            enemyManager.Update(deltaTime, player.getPlayerPosition());
-            if (enemyManager.GetEnemyCount() == 0)
+            else if (const auto* key = event->getIf<sf::Event::KeyPressed>())
             {
-                gameState.setGameState(States::WIN);
-                victory.play();
-                winDelayTimer = 0.0f;
-                std::cout << "All enemies defeated! Transitioning to WIN state" << std::endl;
-            }
-            if (player.getHealth() <= 0)
-            {
-                gameState.setGameState(States::LOSS);
-                lossDelayTimer = 0.0f;
-                lossSceneInitialized = false;
-                std::cout << "Player died! Transitioning to LOSS state" << std::endl;
-            }
-            break;
-        }
-        case States::WIN:
-        {
-            winDelayTimer += deltaTime;
-            player.Update(deltaTime, player.getPlayerPosition());
-            player.resetTransform();
-            if (winDelayTimer >= WIN_DELAY)
-            {
-                // Advance to next stage
-                stageManager.incrementStage();
-                map.setCurrentLevel(stageManager.getCurrentStage());
-
-                std::string nextMapFile = stageManager.getMapFile(stageManager.getCurrentStage());
-                if (!nextMapFile.empty()) {
-                    map.loadFromFile(nextMapFile);
-                    std::cout << "Loaded stage " << stageManager.getCurrentStage() << ": " << nextMapFile << std::endl;
-                }
-                else {
-                    std::cerr << "Failed to load stage " << stageManager.getCurrentStage() << std::endl;
-                    map.setCurrentLevel(stageManager.getCurrentStage()); 
-                    map.loadFromFile(stageManager.getMapFile(stageManager.getCurrentStage()));
-                }
-
-                enemyManager.ClearAllEnemies();
-                enemyManager.ClearAllRocks();
-                enemyManager.SpawnEnemiesFromMap();
-                enemyManager.SpawnRocksFromMap();
-
-                // Update spawn position for new map
-                const auto& spawns = map.getEntitySpawns();
-                for (const auto& spawn : spawns) {
-                    if (spawn.first == '*') {
-                        startPos = spawn.second;
-                        break;
-                    }
-                }
-
-                gameState.setGameState(States::START);
-                std::cout << "Stage " << stageManager.getCurrentStage() << " started" << std::endl;
-            }
-            break;
-        }
-        case States::LOSS:
-        {
-            // Initialize loss scene on first entry
-            if (!lossSceneInitialized) {
-                // Decrement lives ONCE when entering LOSS state
-                player.setLives(player.getLives() - 1);
-
-                // Play appropriate music based on lives remaining AFTER decrementing
-                if (player.getLives() > 0) {
-                    lossMusic.play();
-                    std::cout << "Player died! Lives remaining: " << player.getLives() << std::endl;
-                }
-                else {
-                    noLivesMusic.play();
-                    std::cout << "Player died! No lives remaining. Game Over!" << std::endl;
-                }
-
-                lossSceneInitialized = true;
-                lossDelayTimer = 0.0f;
-            }
-
-            lossDelayTimer += deltaTime;
-
-            // Continue updating player to show death animation
-            player.Update(deltaTime, player.getPlayerPosition());
-
-            if (lossDelayTimer >= LOSS_DELAY) {
-                if (player.getLives() <= 0) {
-                    // Game over - restart from stage 0
-                    noLivesMusic.play();
-                    stageManager.setCurrentStage(0);
-                    map.setCurrentLevel(stageManager.getCurrentStage());
-
-                    std::string firstMapFile = stageManager.getMapFile(stageManager.getCurrentStage());
-                    if (!firstMapFile.empty()) {
-                        map.loadFromFile(firstMapFile);
-                    }
-
-                    enemyManager.ClearAllEnemies();
-                    enemyManager.ClearAllRocks();
-                    enemyManager.SpawnEnemiesFromMap();
-                    enemyManager.SpawnRocksFromMap();
-
-                    // Update spawn position for first map
-                    const auto& spawns = map.getEntitySpawns();
-                    for (const auto& spawn : spawns) {
-                        if (spawn.first == '*') {
-                            startPos = spawn.second;
-                            break;
-                        }
-                    }
-
-                    // Reset lives for new game
-                    player.setLives(3);
-                    std::cout << "Game Over - Restarting from Stage 0 with 3 lives" << std::endl;
+                if (key->code == sf::Keyboard::Key::F3)
+                {
+                    profilerOverlay.SetVisible(!profilerOverlay.IsVisible());
+                    Profiler::SetEnabled(profilerOverlay.IsVisible() || !profileFile.empty());
                 }
-                else {
-                    // Still have lives - restart current stage
-                    std::cout << "Restarting current stage with " << player.getLives() << " lives remaining" << std::endl;
+                else if (key->code == sf::Keyboard::Key::F4 && Profiler::IsEnabled())
+                {
+                    Profiler::ExportChromeTrace(traceFile);
                 }
-
-                // Stop music and transition to start state
-                lossMusic.stop();
-                noLivesMusic.stop();
-
-                // Reset the loss scene flag for next time
-                lossSceneInitialized = false;
-
-                gameState.setGameState(States::START);
             }
-            break;
-        }
         }
 
-        if (gameState.getGameState() != previousState)
-        {
-            previousState = gameState.getGameState();
-        }
+        game.Advance(deltaTime);
 
         // - - - - - - - - - - - - Draw - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
         window.clear(sf::Color::Black);
-        map.draw(window);
-        player.Draw(window);
-        enemyManager.Draw(window);
-        sf::String lives = std::to_string(player.getLives());
+        game.Draw(window);
+        sf::String lives = std::to_string(game.getPlayer().getLives());
         livesText.setString(lives);
         window.draw(livesText);
 
-        if (gameState.getGameState() == States::START)
+        if (game.getState() == States::START)
         {
             window.draw(startText);
         }
-        else if (gameState.getGameState() == States::WIN)
+        else if (game.getState() == States::WIN)
         {
             window.draw(winText);
         }
-        else if (gameState.getGameState() == States::LOSS)
+        else if (game.getState() == States::LOSS)
         {
             window.draw(lossText);
         }
+        profilerOverlay.Draw(window);
         window.display();
+        Profiler::EndFrame();
+        profilerOverlay.Update();
         // - - - - - - - - - - - - Draw - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - 
     }
-}
\ No newline at end of file
+
+    if (!profileFile.empty()) {
+        Profiler::ExportChromeTrace(profileFile);
+    }
+}
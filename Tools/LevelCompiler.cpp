@@ -0,0 +1,72 @@
+// Offline level compiler: turns .rmap text levels into the binary .bmap format that
+// Map::loadFromFile maps and reads in place. StageManager picks up a .bmap next to
+// its .rmap automatically as long as it was compiled from the current text.
+// Usage: digdug_levelc <level.rmap>... [-o <out.bmap>]
+//        (-o only with a single input; otherwise each output goes next to its input)
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "LevelData.h"
+#include "Log.h"
+#include "MappedLevel.h"
+
+static bool compileLevel(const std::string& input, const std::string& output) {
+    ParsedLevel parsed;
+    if (!parsed.loadFromFile(input)) {
+        return false;
+    }
+    LevelData level = parsed.view();
+    if (!Bmap::write(level, parsed.getSourceHash(), output)) {
+        return false;
+    }
+
+    // Read it back through the runtime loader so a bad file never ships
+    MappedLevel mapped;
+    if (!mapped.open(output)) {
+        return false;
+    }
+    const LevelData& check = mapped.data();
+    if (check.width != level.width || check.height != level.height ||
+        !std::equal(check.tiles.begin(), check.tiles.end(), level.tiles.begin()) ||
+        check.spawns.size() != level.spawns.size() || check.rocks.size() != level.rocks.size()) {
+        std::cerr << output << ": verification failed" << '\n';
+        return false;
+    }
+    std::cout << input << " -> " << output << " (" << level.width << "x" << level.height << ", "
+        << level.spawns.size() << " spawns, " << level.rocks.size() << " rocks, "
+        << std::filesystem::file_size(output) << " bytes)" << '\n';
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    std::string output;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        }
+        else {
+            inputs.push_back(arg);
+        }
+    }
+    if (inputs.empty() || (!output.empty() && inputs.size() > 1)) {
+        std::cerr << "Usage: " << argv[0] << " <level.rmap>... [-o <out.bmap>]" << '\n';
+        return 1;
+    }
+
+    Log::SetLevel(LogLevel::Warning);
+    int failures = 0;
+    for (const std::string& input : inputs) {
+        std::string target = output.empty()
+            ? std::filesystem::path(input).replace_extension(Bmap::EXTENSION).string()
+            : output;
+        if (!compileLevel(input, target)) {
+            failures++;
+        }
+    }
+    Log::Flush();
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+# LTO, PGO and sanitizer switches. These are applied to every target in the tree,
+# so the core library, the game and the benchmarks are always built the same way.
+
+# Link-time optimisation
+if(DIGDUG_ENABLE_LTO)
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT lto_supported OUTPUT lto_error LANGUAGES CXX)
+    if(NOT lto_supported)
+        message(FATAL_ERROR "DIGDUG_ENABLE_LTO: not supported by this toolchain: ${lto_error}")
+    endif()
+    set(CMAKE_INTERPROCEDURAL_OPTIMIZATION ON)
+endif()
+
+# Profile-guided optimisation. Typical flow:
+#   1. configure with -DDIGDUG_PGO=GENERATE, build, run a representative workload
+#      (e.g. `digdug --headless --replay <file>` or the benchmarks)
+#   2. Clang only: llvm-profdata merge -o ${DIGDUG_PGO_DIR}/default.profdata ${DIGDUG_PGO_DIR}/*.profraw
+#   3. reconfigure with -DDIGDUG_PGO=USE and rebuild
+string(TOUPPER "${DIGDUG_PGO}" pgo_mode)
+if(pgo_mode STREQUAL "GENERATE")
+    file(MAKE_DIRECTORY "${DIGDUG_PGO_DIR}")
+    if(MSVC)
+        add_compile_options(/GL)
+        add_link_options(/LTCG /GENPROFILE:PGD=${DIGDUG_PGO_DIR}/digdug.pgd)
+    else()
+        add_compile_options(-fprofile-generate=${DIGDUG_PGO_DIR})
+        add_link_options(-fprofile-generate=${DIGDUG_PGO_DIR})
+    endif()
+elseif(pgo_mode STREQUAL "USE")
+    if(MSVC)
+        add_compile_options(/GL)
+        add_link_options(/LTCG /USEPROFILE:PGD=${DIGDUG_PGO_DIR}/digdug.pgd)
+    elseif(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        add_compile_options(-fprofile-use=${DIGDUG_PGO_DIR}/default.profdata -Wno-profile-instr-unprofiled)
+        add_link_options(-fprofile-use=${DIGDUG_PGO_DIR}/default.profdata)
+    else()
+        # Sources without a profile (e.g. not exercised by the training run) are fine
+        add_compile_options(-fprofile-use=${DIGDUG_PGO_DIR} -fprofile-correction -Wno-missing-profile)
+        add_link_options(-fprofile-use=${DIGDUG_PGO_DIR})
+    endif()
+elseif(NOT pgo_mode STREQUAL "OFF" AND NOT pgo_mode STREQUAL "")
+    message(FATAL_ERROR "DIGDUG_PGO must be OFF, GENERATE or USE (got '${DIGDUG_PGO}')")
+endif()
+
+# Sanitizers
+if(DIGDUG_SANITIZERS)
+    if(MSVC)
+        if(NOT DIGDUG_SANITIZERS STREQUAL "address")
+            message(FATAL_ERROR "DIGDUG_SANITIZERS: MSVC only supports 'address'")
+        endif()
+        add_compile_options(/fsanitize=address)
+    else()
+        add_compile_options(-fsanitize=${DIGDUG_SANITIZERS} -fno-omit-frame-pointer -fno-sanitize-recover=all)
+        add_link_options(-fsanitize=${DIGDUG_SANITIZERS})
+    endif()
+endif()
+
+message(STATUS "DIGDUG: LTO=${DIGDUG_ENABLE_LTO} PGO=${DIGDUG_PGO} sanitizers='${DIGDUG_SANITIZERS}'")
@@ -0,0 +1,25 @@
+# Provides the SFML::Graphics, SFML::Window, SFML::System and SFML::Audio targets.
+# Prefers an installed SFML 3 (point SFML_DIR or CMAKE_PREFIX_PATH at it), otherwise
+# builds the pinned release from source. The libraries in dependencies/sfml are
+# MSVC-only and are used by the Visual Studio project, not here.
+
+find_package(SFML 3 COMPONENTS Graphics Window System Audio CONFIG QUIET)
+
+if(SFML_FOUND)
+    message(STATUS "DIGDUG: using installed SFML ${SFML_VERSION}")
+elseif(DIGDUG_FETCH_SFML)
+    message(STATUS "DIGDUG: SFML 3 not found, fetching it")
+    include(FetchContent)
+    FetchContent_Declare(SFML
+        GIT_REPOSITORY https://github.com/SFML/SFML.git
+        GIT_TAG 3.0.1
+        GIT_SHALLOW ON
+        SYSTEM)
+    set(SFML_BUILD_NETWORK OFF CACHE BOOL "" FORCE)
+    set(SFML_BUILD_EXAMPLES OFF CACHE BOOL "" FORCE)
+    set(SFML_BUILD_DOC OFF CACHE BOOL "" FORCE)
+    set(BUILD_SHARED_LIBS OFF CACHE BOOL "" FORCE)
+    FetchContent_MakeAvailable(SFML)
+else()
+    message(FATAL_ERROR "SFML 3 not found. Set SFML_DIR, or enable DIGDUG_FETCH_SFML.")
+endif()